@@ -0,0 +1,322 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+
+//every operation is repeated until it has run for this long, and at least Min_Runs times
+#define Min_Seconds 0.25
+#define Min_Runs 3
+
+//paints per run of the paint operation
+#define Paint_Count 1000
+
+//seed of the maps and of the colorings, every run measures the same ones
+#define Bench_Seed 12345
+
+//the solved coloring for the sweep gives up after this many nodes per region, as autoSolve does
+#define Nodes_PerRegion 100
+
+typedef enum {
+    Layout_Matrix,
+    Layout_Bits,
+    Layout_List,
+    Layout_Count
+} Layout;
+
+static const char *const LAYOUT_NAMES[Layout_Count] = { "byte matrix", "bitset", "list" };
+
+typedef enum {
+    Op_Check,
+    Op_Paint,
+    Op_Sweep,
+    Op_Count
+} Op;
+
+/*one map in all three layouts: a byte per region pair as the game once had it, a bitset row per region with a
+ *mask per color, and the neighbour lists of the game */
+typedef struct {
+    int count;
+    const int *start;
+    const int *list;
+    Uint8 *matrix;
+    RegionBits bits;
+
+    int *colors;
+    Uint8 *conflicts; // per region, kept by the paint operation
+} Adjacency;
+
+typedef struct {
+    double seconds;
+    int runs; // operations timed so far
+} Timing;
+
+static double secondsSince(const Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static bool timingDone(const Timing *timing) {
+    return timing->runs >= Min_Runs && timing->seconds >= Min_Seconds;
+}
+
+//a neighbour of region has its color
+static bool clashes(const Adjacency *adjacency, const Layout layout, const int region) {
+    const int color = adjacency->colors[region];
+    if (color < 0)
+        return false;
+
+    switch (layout) {
+        case Layout_Matrix: {
+            const Uint8 *row = adjacency->matrix + (size_t)region * adjacency->count;
+            for (int j = 0; j < adjacency->count; ++j) {
+                if (row[j] && adjacency->colors[j] == color)
+                    return true;
+            }
+            return false;
+        }
+        case Layout_Bits:
+            return regionBitsClash(&adjacency->bits, region, color);
+        default:
+            for (int k = adjacency->start[region]; k < adjacency->start[region + 1]; ++k) {
+                if (adjacency->colors[adjacency->list[k]] == color)
+                    return true;
+            }
+            return false;
+    }
+}
+
+//paint one region and update the conflict flag of it and of its neighbours, as mouse_input does
+static void paint(Adjacency *adjacency, const Layout layout, const int region, const int color) {
+    if (layout == Layout_Bits)
+        regionBitsPaint(&adjacency->bits, region, adjacency->colors[region], color);
+    adjacency->colors[region] = color;
+    adjacency->conflicts[region] = clashes(adjacency, layout, region);
+
+    //the matrix has no list of neighbours, its row is scanned for them. The bitset uses the lists like the game
+    if (layout == Layout_Matrix) {
+        const Uint8 *row = adjacency->matrix + (size_t)region * adjacency->count;
+        for (int j = 0; j < adjacency->count; ++j) {
+            if (row[j])
+                adjacency->conflicts[j] = clashes(adjacency, layout, j);
+        }
+    } else {
+        for (int k = adjacency->start[region]; k < adjacency->start[region + 1]; ++k)
+            adjacency->conflicts[adjacency->list[k]] = clashes(adjacency, layout, adjacency->list[k]);
+    }
+}
+
+//what winCheck would have to do without its counters: every region painted and none in conflict
+static bool sweep(const Adjacency *adjacency, const Layout layout) {
+    if (layout == Layout_Bits)
+        return regionBitsSolved(&adjacency->bits);
+
+    for (int i = 0; i < adjacency->count; ++i) {
+        if (adjacency->colors[i] < 0 || clashes(adjacency, layout, i))
+            return false;
+    }
+    return true;
+}
+
+//colors for every region and masks to match
+static void colorsSet(Adjacency *adjacency, const int *colors) {
+    regionBitsClear(&adjacency->bits);
+    for (int i = 0; i < adjacency->count; ++i) {
+        adjacency->colors[i] = colors[i];
+        regionBitsPaint(&adjacency->bits, i, -1, colors[i]);
+    }
+}
+
+/*time one operation in one layout. The result is the number of regions in conflict for a check, the flags
+ *after the paints are left in adjacency->conflicts, and a sweep returns whether the map is solved */
+static int timeOp(Adjacency *adjacency, const Layout layout, const Op op, const int *colors, const int *paints,
+    Timing *timing) {
+    int result = 0;
+    while (!timingDone(timing)) {
+        colorsSet(adjacency, colors);
+        for (int i = 0; i < adjacency->count; ++i)
+            adjacency->conflicts[i] = 0;
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (op == Op_Check) {
+            result = 0;
+            for (int i = 0; i < adjacency->count; ++i)
+                result += clashes(adjacency, layout, i);
+            timing->runs += adjacency->count;
+        } else if (op == Op_Paint) {
+            for (int i = 0; i < Paint_Count; ++i)
+                paint(adjacency, layout, paints[i * 2], paints[i * 2 + 1]);
+            timing->runs += Paint_Count;
+        } else {
+            result = sweep(adjacency, layout);
+            timing->runs++;
+        }
+        timing->seconds += secondsSince(start);
+    }
+    return result;
+}
+
+/*every operation in every layout on the current map of game. Check is one conflictCheck on a partly colored map,
+ *paint a click with the conflict updates around it, sweep a full win check on a solved map. The layouts have
+ *to agree on every answer */
+static bool benchAdjacency(Adjacency *adjacency, struct Game *game) {
+    const int count = game->regionCount;
+    ColoringSolver solver = {0};
+    ColoringStats stats;
+
+    int *partial = (int*)malloc(count * sizeof(int));
+    int *paints = (int*)malloc(Paint_Count * 2 * sizeof(int));
+    Uint8 *conflicts = (Uint8*)malloc(count);
+    if (!partial || !paints || !conflicts) {
+        fprintf(stderr, "Failed to allocate memory for the colorings of %d regions\n", count);
+        free(partial);
+        free(paints);
+        free(conflicts);
+        return false;
+    }
+
+    //a fifth of the regions uncolored, the rest at random
+    Rng rng;
+    rngSeed(&rng, Bench_Seed);
+    for (int i = 0; i < count; ++i)
+        partial[i] = (int)rngBelow(&rng, Color_Count + 1) - 1;
+    for (int i = 0; i < Paint_Count; ++i) {
+        paints[i * 2] = (int)rngBelow(&rng, (Uint32)count);
+        paints[i * 2 + 1] = (int)rngBelow(&rng, Color_Count);
+    }
+
+    bool ok = coloringSolve(&solver, adjacency->start, adjacency->list, count, Color_Count,
+        (long long)count * Nodes_PerRegion, &stats) == Coloring_Done;
+    if (!ok)
+        fprintf(stderr, "The solver could not color the map, there is nothing to sweep\n");
+
+    double seconds[Layout_Count][Op_Count];
+    int checked[Layout_Count];
+    int solved[Layout_Count];
+    for (int layout = 0; layout < Layout_Count && ok; ++layout) {
+        for (int op = 0; op < Op_Count; ++op) {
+            Timing timing = { 0.0, 0 };
+            const int result = timeOp(adjacency, (Layout)layout, (Op)op, op == Op_Sweep ? solver.colors : partial,
+                paints, &timing);
+            seconds[layout][op] = timing.seconds / timing.runs;
+
+            if (op == Op_Check)
+                checked[layout] = result;
+            else if (op == Op_Sweep)
+                solved[layout] = result;
+            else if (layout == 0)
+                memcpy(conflicts, adjacency->conflicts, count);
+            else if (memcmp(conflicts, adjacency->conflicts, count) != 0)
+                ok = false;
+        }
+        if (checked[layout] != checked[0] || !solved[layout])
+            ok = false;
+    }
+
+    if (ok) {
+        const int words = (count + 63) / 64;
+        const double bytes[Layout_Count] = {
+            (double)count * count,
+            (double)count * words * 8 + (double)(Color_Count + 1) * words * 8,
+            (double)(count + 1 + adjacency->start[count]) * sizeof(int)
+        };
+        for (int layout = 0; layout < Layout_Count; ++layout)
+            printf("  %-12s check %8.1f ns  paint %10.1f ns  sweep %12.0f ns  %10.1f KiB\n", LAYOUT_NAMES[layout],
+                seconds[layout][Op_Check] * 1e9, seconds[layout][Op_Paint] * 1e9, seconds[layout][Op_Sweep] * 1e9,
+                bytes[layout] / 1024.0);
+        printf("  regions in conflict on the partial coloring: %d\n\n", checked[0]);
+    } else {
+        fprintf(stderr, "The layouts disagree on the map\n");
+    }
+
+    coloringSolverFree(&solver);
+    free(partial);
+    free(paints);
+    free(conflicts);
+    return ok;
+}
+
+//one generated map in all three layouts
+static bool benchMap(struct Game *game, const int count) {
+    game->customRegionCount = count;
+    if (!setDifficulty(game, Custom))
+        return false;
+
+    char mapId[MapId_Size];
+    mapIdFormat(game, mapId, sizeof(mapId));
+    printf("%d regions, %d neighbour pairs, map %s\n", game->regionCount,
+        game->adjucencyStart[game->regionCount] / 2, mapId);
+
+    Adjacency adjacency = { game->regionCount, game->adjucencyStart, game->adjucencyList, NULL, {0}, NULL, NULL };
+    adjacency.matrix = (Uint8*)calloc((size_t)count * count, 1);
+    adjacency.colors = (int*)malloc(count * sizeof(int));
+    adjacency.conflicts = (Uint8*)malloc(count);
+
+    bool ok = adjacency.matrix && adjacency.colors && adjacency.conflicts &&
+        regionBitsReset(&adjacency.bits, count, Color_Count) &&
+        regionBitsRows(&adjacency.bits, adjacency.start, adjacency.list);
+    if (ok) {
+        for (int i = 0; i < count; ++i) {
+            for (int k = adjacency.start[i]; k < adjacency.start[i + 1]; ++k)
+                adjacency.matrix[(size_t)i * count + adjacency.list[k]] = 1;
+        }
+        ok = benchAdjacency(&adjacency, game);
+    } else {
+        fprintf(stderr, "Failed to allocate memory for the adjacency of %d regions\n", count);
+    }
+
+    regionBitsFree(&adjacency.bits);
+    free(adjacency.matrix);
+    free(adjacency.colors);
+    free(adjacency.conflicts);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    static const int defaultCounts[] = { 100, 1000, 4000 };
+
+    //nothing is shown, the map is only generated to get its adjacency
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    //usage: Adjacency_Benchmark [WIDTHxHEIGHT] [REGIONS ...], bitset rows stop at RegionBits_MaxRows regions
+    int width = 1920;
+    int height = 1080;
+    int counts[16];
+    int countCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strchr(argv[i], 'x')) {
+            sscanf(argv[i], "%dx%d", &width, &height);
+        } else if (atoi(argv[i]) > 0 && countCount < 16) {
+            const int count = atoi(argv[i]);
+            counts[countCount++] = count < RegionBits_MaxRows ? count : RegionBits_MaxRows;
+        }
+    }
+    if (countCount == 0) {
+        countCount = (int)(sizeof(defaultCounts) / sizeof(defaultCounts[0]));
+        memcpy(counts, defaultCounts, sizeof(defaultCounts));
+    }
+
+    struct Game game = {
+        .mapWidth = width,
+        .mapHeight = height,
+        .labelEngine = LabelEngine_Blocks,
+        .difficulty = Custom,
+        .gameState = Game,
+    };
+    if (sdl_initialise(&game)) {
+        game_cleanup(&game);
+        return EXIT_FAILURE;
+    }
+    rngSeed(&game.rng, Bench_Seed);
+
+    printf("%dx%d\n", width, height);
+    bool ok = true;
+    for (int i = 0; i < countCount && ok; ++i)
+        ok = benchMap(&game, counts[i]);
+
+    game_cleanup(&game);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
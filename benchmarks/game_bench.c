@@ -0,0 +1,515 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+//every phase is repeated until it has run for this long, and at least Min_Runs times
+#define Min_Seconds 0.25
+#define Min_Runs 3
+
+//clicks per run of the recolor phase
+#define Click_Count 1000
+
+//seed of the map generator, the clicks use rand() seeded with the same value
+#define Bench_Seed 12345
+
+//points per run of the pick phases, and the longest step in pixels between two points of a drag
+#define Pick_Count 10000
+#define Drag_Step 4
+
+//cells times regions up to which the label map is built once more with the linear scan and compared
+#define Linear_MaxWork 200000000LL
+
+/*a strip as wide as a map can be with five regions, the nearest seed of many of its pixels is more than 10000
+ *pixels away. Run after the default sizes for the linear scan on squared distances that come close to INT_MAX */
+#define Wide_Map "0c60048c4e96e033-5-32768x64"
+
+typedef struct {
+    const char *name;
+    double seconds;
+    int runs; // operations timed so far
+    long long pixels; // pixels produced per run, 0 if the phase does not rasterize
+} Phase;
+
+static double secondsSince(const Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+//peak resident set size of the process in MiB, 0 if it is unknown
+static double peakRssMiB(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0.0;
+    return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0.0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+    return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+#endif
+}
+
+static void phasePrint(const Phase *phase) {
+    const double perRun = phase->seconds / phase->runs;
+
+    printf("  %-24s %14.0f ns/op", phase->name, perRun * 1e9);
+    if (phase->pixels > 0)
+        printf(" %10.1f Mpx/s", phase->pixels / perRun / 1e6);
+    printf("  (%d ops)\n", phase->runs);
+}
+
+static bool phaseDone(const Phase *phase) {
+    return phase->runs >= Min_Runs && phase->seconds >= Min_Seconds;
+}
+
+typedef enum {
+    Pick_Walk, // regionAt, as the game picks
+    Pick_Index, // nearest seed search in the seed index
+    Pick_Labels, // owner of the cell in the label map, without the walk
+} Pick;
+
+//the region under every point
+static void pickTime(const struct Game *game, const SDL_Point *points, const Pick pick, int *regions, Phase *phase) {
+    const int gridCols = game->mapWidth / Cell_Size;
+    while (!phaseDone(phase)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < Pick_Count; ++i) {
+            const int x = points[i].x;
+            const int y = points[i].y;
+            if (pick == Pick_Walk)
+                regions[i] = regionAt(game, x, y);
+            else if (pick == Pick_Index)
+                regions[i] = seedIndexNearest(&game->seedIndex, x, y);
+            else
+                regions[i] = game->labelMap[(y / Cell_Size) * gridCols + x / Cell_Size];
+        }
+        phase->seconds += secondsSince(start);
+        phase->runs += Pick_Count;
+    }
+}
+
+//picks in the walk and in the seed index that disagree
+static int pickMismatches(const int *walked, const int *indexed) {
+    int mismatches = 0;
+    for (int i = 0; i < Pick_Count; ++i)
+        mismatches += walked[i] != indexed[i];
+    return mismatches;
+}
+
+static int labelMismatchCount(const int *expected, const int *labels, const int cells) {
+    int mismatches = 0;
+    for (int i = 0; i < cells; ++i)
+        mismatches += expected[i] != labels[i];
+    return mismatches;
+}
+
+/*time every phase of setDifficulty and of a frame for one map size and region count. The phases depend on each
+ *other, so a map is generated, labeled and triangulated in that order and each step is timed on its own */
+static bool benchMap(struct Game *game, const int count) {
+    const long long mapPixels = (long long)game->mapWidth * game->mapHeight;
+
+    game->customRegionCount = count;
+    if (!setDifficulty(game, Custom))
+        return false;
+
+    Phase generator = { "regionsGenerator", 0.0, 0, 0 };
+    Phase labels = { "labelMapBuild", 0.0, 0, mapPixels };
+    Phase adjacency = { "adjucencyCheck", 0.0, 0, 0 };
+    Phase polygons = { "regionPolygonsBuild", 0.0, 0, 0 };
+
+    //the four run in lockstep, so the time limit goes for all of them together
+    while (polygons.runs < Min_Runs ||
+        generator.seconds + labels.seconds + adjacency.seconds + polygons.seconds < Min_Seconds) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        regionsGenerator(game);
+        generator.seconds += secondsSince(start);
+        generator.runs++;
+
+        start = SDL_GetPerformanceCounter();
+        labelMapBuild(game);
+        labels.seconds += secondsSince(start);
+        labels.runs++;
+
+        start = SDL_GetPerformanceCounter();
+        adjucencyCheck(game);
+        adjacency.seconds += secondsSince(start);
+        adjacency.runs++;
+
+        start = SDL_GetPerformanceCounter();
+        regionPolygonsBuild(game);
+        polygons.seconds += secondsSince(start);
+        polygons.runs++;
+    }
+
+    const int queries = SDL_AtomicGet(&game->labelQueries);
+
+    /*every other engine has to give exactly the label map of the nearest seed search, and so does the linear scan
+     *the game falls back to without a seed index, on maps where it does not take long */
+    const LabelEngine engine = game->labelEngine;
+    const int cells = (game->mapWidth / Cell_Size) * (game->mapHeight / Cell_Size);
+    const bool linearChecked = (long long)cells * game->regionCount <= Linear_MaxWork;
+    int labelMismatches = 0;
+    int linearMismatches = 0;
+    if (engine != LabelEngine_Nearest || linearChecked) {
+        int *labels = (int*)malloc(cells * sizeof(int));
+        if (!labels) {
+            fprintf(stderr, "Failed to allocate memory for %d labels\n", cells);
+            return false;
+        }
+
+        memcpy(labels, game->labelMap, cells * sizeof(int));
+        game->labelEngine = LabelEngine_Nearest;
+        if (engine != LabelEngine_Nearest) {
+            labelMapBuild(game);
+            labelMismatches = labelMismatchCount(labels, game->labelMap, cells);
+        }
+        if (linearChecked) {
+            seedIndexFree(&game->seedIndex);
+            labelMapBuild(game);
+            linearMismatches = labelMismatchCount(labels, game->labelMap, cells);
+            if (!seedIndexBuild(&game->seedIndex, &game->regions[0].point, sizeof(Region), game->regionCount,
+                game->mapWidth, game->mapHeight)) {
+                fprintf(stderr, "Failed to build the seed index again\n");
+                free(labels);
+                return false;
+            }
+        }
+        game->labelEngine = engine;
+        free(labels);
+    }
+
+    //the last map is played on, so the counters have to match it
+    game->uncoloredCount = game->regionCount;
+    game->conflictCount = 0;
+    for (int i = 0; i < (game->regionCount + 31) / 32; ++i)
+        game->conflictBits[i] = 0;
+
+    //rasterizing the whole map into the pixel buffer, nothing is uploaded
+    Phase paint = { "mapPaint (full)", 0.0, 0, mapPixels };
+    const SDL_Rect all = { 0, 0, game->mapWidth / Cell_Size, game->mapHeight / Cell_Size };
+    while (!phaseDone(&paint)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        mapPaint(game, &all);
+        paint.seconds += secondsSince(start);
+        paint.runs++;
+    }
+
+    //a whole frame after a new map: repaint, upload, copy, dots and palette
+    Phase frame = { "game_renderer (full)", 0.0, 0, mapPixels };
+    while (!phaseDone(&frame)) {
+        game->repaintAll = true;
+        const Uint64 start = SDL_GetPerformanceCounter();
+        game_renderer(game);
+        frame.seconds += secondsSince(start);
+        frame.runs++;
+    }
+
+    //one click on a random pixel with the next color, then the frame that shows it
+    Phase recolor = { "click + frame", 0.0, 0, 0 };
+    while (!phaseDone(&recolor)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < Click_Count; ++i) {
+            game->chosenColor = (game->chosenColor + 1) % Color_Count;
+            mouse_input(game, rand() % game->mapWidth, rand() % game->mapHeight);
+            game_renderer(game);
+        }
+        recolor.seconds += secondsSince(start);
+        recolor.runs += Click_Count;
+    }
+
+    //the same two with the polygons: all vertices colored and drawn, then clicks that recolor a few of them
+    game->mapRender = MapRender_Polygons;
+    Phase polygonFrame = { "polygon frame (full)", 0.0, 0, 0 };
+    while (!phaseDone(&polygonFrame)) {
+        game->repaintAll = true;
+        const Uint64 start = SDL_GetPerformanceCounter();
+        game_renderer(game);
+        polygonFrame.seconds += secondsSince(start);
+        polygonFrame.runs++;
+    }
+
+    Phase polygonRecolor = { "click + polygon frame", 0.0, 0, 0 };
+    while (!phaseDone(&polygonRecolor)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < Click_Count; ++i) {
+            game->chosenColor = (game->chosenColor + 1) % Color_Count;
+            mouse_input(game, rand() % game->mapWidth, rand() % game->mapHeight);
+            game_renderer(game);
+        }
+        polygonRecolor.seconds += secondsSince(start);
+        polygonRecolor.runs += Click_Count;
+    }
+    const bool polygonsDrawn = game->mapRender == MapRender_Polygons;
+
+    /*picking regions along a drag, a few pixels between points, and at random points all over the map. The walk
+     *has to find the same regions as the nearest seed search, the label map looks at cell centers. The label map
+     *is only read for points inside its whole cells */
+    SDL_Point *points = (SDL_Point*)malloc(Pick_Count * 2 * sizeof(SDL_Point));
+    int *picks = (int*)malloc(Pick_Count * 4 * sizeof(int));
+    if (!points || !picks) {
+        fprintf(stderr, "Failed to allocate memory for %d picks\n", Pick_Count);
+        free(points);
+        free(picks);
+        return false;
+    }
+    SDL_Point *drag = points;
+    SDL_Point *scattered = points + Pick_Count;
+    const int pickWidth = game->mapWidth / Cell_Size * Cell_Size;
+    const int pickHeight = game->mapHeight / Cell_Size * Cell_Size;
+    drag[0].x = game->mapWidth / 2;
+    drag[0].y = game->mapHeight / 2;
+    for (int i = 0; i < Pick_Count; ++i) {
+        if (i > 0) {
+            const int x = drag[i - 1].x + rand() % (Drag_Step * 2 + 1) - Drag_Step;
+            const int y = drag[i - 1].y + rand() % (Drag_Step * 2 + 1) - Drag_Step;
+            drag[i].x = SDL_clamp(x, 0, game->mapWidth - 1);
+            drag[i].y = SDL_clamp(y, 0, game->mapHeight - 1);
+        }
+        scattered[i].x = rand() % pickWidth;
+        scattered[i].y = rand() % pickHeight;
+    }
+
+    Phase pickDrag = { "pick drag (walk)", 0.0, 0, 0 };
+    Phase pickDragIndex = { "pick drag (seed index)", 0.0, 0, 0 };
+    Phase pickScattered = { "pick random (walk)", 0.0, 0, 0 };
+    Phase pickIndex = { "pick random (seed index)", 0.0, 0, 0 };
+    Phase pickCells = { "pick random (label map)", 0.0, 0, 0 };
+    int pickErrors = 0;
+    game->mapRender = MapRender_Cells;
+    game->repaintAll = true;
+
+    pickTime(game, drag, Pick_Walk, picks, &pickDrag);
+    pickTime(game, drag, Pick_Index, picks + Pick_Count, &pickDragIndex);
+    pickErrors += pickMismatches(picks, picks + Pick_Count);
+
+    pickTime(game, scattered, Pick_Walk, picks, &pickScattered);
+    pickTime(game, scattered, Pick_Index, picks + Pick_Count, &pickIndex);
+    pickErrors += pickMismatches(picks, picks + Pick_Count);
+
+    pickTime(game, scattered, Pick_Labels, picks + Pick_Count * 2, &pickCells);
+    const int cellMisses = pickMismatches(picks + Pick_Count * 2, picks + Pick_Count);
+    free(points);
+    free(picks);
+
+    //every region has to be paintable, also the ones that own no cell center, at least by a click on its seed
+    int cellless = 0;
+    int unpickable = 0;
+    for (int i = 0; i < game->regionCount; ++i) {
+        const SDL_Point *seed = &game->regions[i].point;
+        cellless += game->regionBounds[i].w == 0;
+        if (regionAt(game, seed->x, seed->y) != i)
+            ++unpickable;
+    }
+
+    //four-coloring the adjacency graph, every solution is checked for neighbours that share a color
+    Phase solve = { "autoSolve", 0.0, 0, 0 };
+    ColoringStats solveStats = { 0, 0, 0, 0.0 };
+    ColoringResult solveResult = Coloring_Done;
+    while (solveResult == Coloring_Done && !phaseDone(&solve)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        solveResult = autoSolve(game, &solveStats);
+        solve.seconds += secondsSince(start);
+        solve.runs++;
+    }
+    int solveConflicts = 0;
+    for (int i = 0; solveResult == Coloring_Done && i < game->regionCount; ++i) {
+        if (game->regions[i].colorIndex < 0 || conflictCheck(game, i))
+            solveConflicts++;
+    }
+
+    /*random clicks on the solved map with auto-fix on, every click that clashes is repaired over Kempe chains.
+     *The regions of a chain are spread out, so the frame shows what a recolor costs away from one box */
+    Phase fix = { "click + auto-fix + frame", 0.0, 0, 0 };
+    const long long recolored = game->repair.recolored;
+    long long fixMissed = 0;
+    game->autoFix = true;
+    while (solveResult == Coloring_Done && !phaseDone(&fix)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < Click_Count; ++i) {
+            game->chosenColor = rand() % Color_Count;
+            if (mouse_input(game, rand() % game->mapWidth, rand() % game->mapHeight))
+                fixMissed += game->autoFixMissed;
+            game_renderer(game);
+        }
+        fix.seconds += secondsSince(start);
+        fix.runs += Click_Count;
+    }
+    game->autoFix = false;
+
+    char mapId[MapId_Size];
+    mapIdFormat(game, mapId, sizeof(mapId));
+    printf("%dx%d, %d regions, %d threads, %s labels, map %s\n", game->mapWidth, game->mapHeight,
+        game->regionCount, workerPoolSize(&game->workers), labelEngineName(engine), mapId);
+    phasePrint(&generator);
+    phasePrint(&labels);
+    phasePrint(&adjacency);
+    phasePrint(&polygons);
+    phasePrint(&paint);
+    phasePrint(&frame);
+    phasePrint(&recolor);
+    phasePrint(&polygonFrame);
+    phasePrint(&polygonRecolor);
+    phasePrint(&pickDrag);
+    phasePrint(&pickDragIndex);
+    phasePrint(&pickScattered);
+    phasePrint(&pickIndex);
+    phasePrint(&pickCells);
+    phasePrint(&solve);
+    if (solveResult == Coloring_Done) {
+        phasePrint(&fix);
+        printf("  solver: %lld nodes, %lld backtracks, %lld Kempe swaps, regions in conflict %d\n",
+            solveStats.nodes, solveStats.backtracks, solveStats.kempeSwaps, solveConflicts);
+        printf("  auto-fix: %.2f regions recolored per click, %.3f conflicts per click without a swap of at most %d "
+            "regions, %d neighbouring pairs in conflict after it\n", (double)(game->repair.recolored - recolored) / fix.runs,
+            (double)fixMissed / fix.runs, Kempe_MaxChain, game->conflictCount);
+    } else {
+        printf("  solver failed after %lld nodes\n", solveStats.nodes);
+    }
+    printf("  polygons: %d vertices, %d triangles, %d border quads%s\n", game->polygons.count,
+        game->polygons.indexCount / 3, game->polygons.borderCount,
+        polygonsDrawn ? "" : ", SDL_RenderGeometry failed and the cells were drawn");
+    printf("  picks: %d of the walk not at the nearest seed%s, %d of the label map on another region next to a border\n",
+        pickErrors, game->adjucencyTriangulated ? "" : " (no walk, the seed index picked)", cellMisses);
+    printf("  regions without a cell: %d, regions a click on their center does not pick: %d\n", cellless, unpickable);
+    printf("  nearest seed searches per label map: %d (%.3f per cell)\n", queries,
+        (double)queries / ((game->mapWidth / Cell_Size) * (game->mapHeight / Cell_Size)));
+    if (engine != LabelEngine_Nearest)
+        printf("  label mismatches against the nearest seed search: %d\n", labelMismatches);
+    if (linearChecked)
+        printf("  label mismatches of the linear scan against the seed index: %d\n", linearMismatches);
+    printf("  peak RSS %.1f MiB\n\n", peakRssMiB());
+    return labelMismatches == 0 && linearMismatches == 0 && solveResult == Coloring_Done && solveConflicts == 0 && polygonsDrawn &&
+        pickErrors == 0 && unpickable == 0;
+}
+
+/*one map size, a fresh window and renderer for it. The generator is seeded the same way for every size, so a
+ *run gives the same maps each time. mapSeed is the seed of the first map if it is not NULL */
+static bool benchSize(const int width, const int height, const int *counts, const int countCount, const int threads,
+    const LabelEngine engine, const Uint64 *mapSeed) {
+    struct Game game = {
+        .mapWidth = width,
+        .mapHeight = height,
+        .labelEngine = engine,
+        .difficulty = Custom,
+        .gameState = Game,
+    };
+
+    if (sdl_initialise(&game)) {
+        game_cleanup(&game);
+        return false;
+    }
+
+    rngSeed(&game.rng, Bench_Seed);
+    if (mapSeed) {
+        game.mapSeed = *mapSeed;
+        game.mapSeedGiven = true;
+    }
+
+    //the game starts as many threads as there are cores, the benchmark can ask for a different amount
+    if (threads > 0) {
+        workerPoolStop(&game.workers);
+        workerPoolStart(&game.workers, threads - 1);
+    }
+
+    bool ok = true;
+    for (int i = 0; i < countCount && ok; ++i)
+        ok = benchMap(&game, counts[i]);
+
+    game_cleanup(&game);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    static const int defaultCounts[] = { 100, 1000, 10000, 100000 };
+    static const SDL_Point defaultSizes[] = { { 800, 600 }, { 1920, 1080 } };
+
+    //nothing is shown, the renderer draws into the window surface of the dummy driver
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    srand(Bench_Seed);
+
+    int threads = 0;
+    const char *mapId = NULL;
+    LabelEngine engine = LabelEngine_Blocks;
+    SDL_Point sizes[16];
+    int sizeCount = 0;
+    int counts[16];
+    int countCount = 0;
+
+    //sizes and region counts or one map ID, anything else is refused rather than left out of the run
+    bool argumentsOk = true;
+    for (int i = 1; i < argc && argumentsOk; ++i) {
+        int width, height;
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--labels") == 0 && i + 1 < argc) {
+            engine = labelEngineParse(argv[++i], engine);
+        } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc && !mapId) {
+            mapId = argv[++i];
+        } else if (strchr(argv[i], 'x') && sscanf(argv[i], "%dx%d", &width, &height) == 2 && sizeCount < 16) {
+            sizes[sizeCount].x = width;
+            sizes[sizeCount].y = height;
+            ++sizeCount;
+        } else if (atoi(argv[i]) > 0 && countCount < 16) {
+            counts[countCount++] = atoi(argv[i]);
+        } else {
+            argumentsOk = false;
+        }
+    }
+    if (!argumentsOk || (mapId && (sizeCount > 0 || countCount > 0))) {
+        fprintf(stderr, "usage: Game_Benchmark [--threads N] [--labels nearest|blocks|walk|transform] "
+            "[--map ID | [WIDTHxHEIGHT ...] [REGIONS ...]]\n"
+            "  a map ID holds its size and region count, up to 16 sizes and 16 counts\n");
+        return EXIT_FAILURE;
+    }
+
+    //a map ID printed by the game or by an earlier run, the map is built again exactly as it was
+    Uint64 mapSeed;
+    if (mapId) {
+        int count, width, height;
+        if (!mapIdParse(mapId, &mapSeed, &count, &width, &height))
+            return EXIT_FAILURE;
+        sizes[0].x = width;
+        sizes[0].y = height;
+        sizeCount = 1;
+        counts[0] = count;
+        countCount = 1;
+    }
+
+    const bool defaultRun = sizeCount == 0 && countCount == 0;
+    if (sizeCount == 0) {
+        sizeCount = (int)(sizeof(defaultSizes) / sizeof(defaultSizes[0]));
+        memcpy(sizes, defaultSizes, sizeof(defaultSizes));
+    }
+    if (countCount == 0) {
+        countCount = (int)(sizeof(defaultCounts) / sizeof(defaultCounts[0]));
+        memcpy(counts, defaultCounts, sizeof(defaultCounts));
+    }
+
+    bool ok = true;
+    for (int i = 0; i < sizeCount && ok; ++i)
+        ok = benchSize(sizes[i].x, sizes[i].y, counts, countCount, threads, engine, mapId ? &mapSeed : NULL);
+    if (ok && defaultRun) {
+        int count, width, height;
+        ok = mapIdParse(Wide_Map, &mapSeed, &count, &width, &height) &&
+            benchSize(width, height, &count, 1, threads, engine, &mapSeed);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
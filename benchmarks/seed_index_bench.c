@@ -0,0 +1,143 @@
+#include <SDL.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "seed_index.h"
+
+//same plane as the game window
+#define Plane_Width 800
+#define Plane_Height 600
+
+#define Query_Count 200000
+
+//the scan find_closest_region used before the seed index, kept here as the baseline
+static int nearestLinear(const SDL_Point *points, const int count, const int x, const int y) {
+    int closest = 0;
+    int bestDistance = INT_MAX;
+
+    for (int i = 0; i < count; ++i) {
+        const int dx = x - points[i].x;
+        const int dy = y - points[i].y;
+        const int distance = dx * dx + dy * dy;
+
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+static double secondsSince(const Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+/*query throughput of the linear scan and the grid index for one seed count.
+ *Both answer the same random queries and every answer is compared */
+static bool benchSeeds(const int count) {
+    SDL_Point *points = (SDL_Point*)malloc(count * sizeof(SDL_Point));
+    SDL_Point *queries = (SDL_Point*)malloc(Query_Count * sizeof(SDL_Point));
+    if (!points || !queries) {
+        fprintf(stderr, "Failed to allocate memory for %d seeds\n", count);
+        free(points);
+        free(queries);
+        return false;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        points[i].x = rand() % Plane_Width;
+        points[i].y = rand() % Plane_Height;
+    }
+    for (int i = 0; i < Query_Count; ++i) {
+        queries[i].x = rand() % Plane_Width;
+        queries[i].y = rand() % Plane_Height;
+    }
+
+    SeedIndex index = {0};
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!seedIndexBuild(&index, points, sizeof(SDL_Point), count, Plane_Width, Plane_Height)) {
+        fprintf(stderr, "Failed to build the seed index for %d seeds\n", count);
+        free(points);
+        free(queries);
+        return false;
+    }
+    const double buildSeconds = secondsSince(start);
+
+    //the linear scan gets fewer queries on big inputs, otherwise it runs for minutes
+    int linearQueries = (int)(2000000000LL / count / 100);
+    if (linearQueries > Query_Count) linearQueries = Query_Count;
+    if (linearQueries < 1000) linearQueries = 1000;
+
+    int *expected = (int*)malloc(linearQueries * sizeof(int));
+    if (!expected) {
+        fprintf(stderr, "Failed to allocate memory for %d answers\n", linearQueries);
+        seedIndexFree(&index);
+        free(points);
+        free(queries);
+        return false;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < linearQueries; ++i)
+        expected[i] = nearestLinear(points, count, queries[i].x, queries[i].y);
+    const double linearSeconds = secondsSince(start);
+
+    const double linearRate = linearQueries / linearSeconds;
+    printf("%8d seeds | build %8.3f ms | linear %12.0f q/s %10.1f ns/q\n",
+        count, buildSeconds * 1000.0, linearRate, 1e9 / linearRate);
+
+    //the grid with every nearest seed kernel the cpu has, all of them have to agree with the linear scan
+    int mismatches = 0;
+    for (int kernel = 0; kernel < SeedKernel_Count; ++kernel) {
+        if (!seedKernelAvailable((SeedKernel)kernel))
+            continue;
+        seedIndexSetKernel(&index, (SeedKernel)kernel);
+
+        long long checksum = 0;
+        start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < Query_Count; ++i)
+            checksum += seedIndexNearest(&index, queries[i].x, queries[i].y);
+        const double gridSeconds = secondsSince(start);
+
+        int kernelMismatches = 0;
+        for (int i = 0; i < linearQueries; ++i) {
+            if (seedIndexNearest(&index, queries[i].x, queries[i].y) != expected[i])
+                ++kernelMismatches;
+        }
+        mismatches += kernelMismatches;
+
+        const double gridRate = Query_Count / gridSeconds;
+        printf("         grid %-6s %12.0f q/s %8.1f ns/q | x%-8.1f | mismatches %d (checksum %lld)\n",
+            seedKernelName((SeedKernel)kernel), gridRate, 1e9 / gridRate, gridRate / linearRate,
+            kernelMismatches, checksum);
+    }
+
+    free(expected);
+    seedIndexFree(&index);
+    free(points);
+    free(queries);
+    return mismatches == 0;
+}
+
+int main(int argc, char *argv[]) {
+    //seed counts can be given on the command line, the default is the set from the request
+    static const int defaultCounts[] = { 100, 10000, 100000 };
+
+    srand(12345);
+
+    bool ok = true;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            const int count = atoi(argv[i]);
+            if (count > 0)
+                ok = benchSeeds(count) && ok;
+        }
+    } else {
+        for (size_t i = 0; i < sizeof(defaultCounts) / sizeof(defaultCounts[0]); ++i)
+            ok = benchSeeds(defaultCounts[i]) && ok;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
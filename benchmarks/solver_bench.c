@@ -0,0 +1,294 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+
+//every solve is repeated until it has run for this long, and at least Min_Runs times. One that hits the node
+//limit runs once
+#define Min_Seconds 0.25
+#define Min_Runs 3
+
+//a solve gives up after this many nodes per region, as autoSolve does
+#define Nodes_PerRegion 100
+
+//adjacency lists in the layout of the game, neighbours of i are list[start[i] .. start[i + 1])
+typedef struct {
+    const char *name;
+    int *start;
+    int *list;
+    int count;
+} Graph;
+
+typedef struct {
+    ColoringResult result;
+    double seconds; // per solve
+    int runs;
+    ColoringStats stats; // of the last solve
+    bool proper; // the last coloring has no neighbours that share a color
+} Timing;
+
+static double secondsSince(const Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+static const char *resultName(const ColoringResult result) {
+    switch (result) {
+        case Coloring_Done:
+            return "colored";
+        case Coloring_Impossible:
+            return "no coloring";
+        case Coloring_NodeLimit:
+            return "node limit";
+        default:
+            return "out of memory";
+    }
+}
+
+static bool coloringProper(const Graph *graph, const int *colors) {
+    for (int v = 0; v < graph->count; ++v) {
+        for (int k = graph->start[v]; k < graph->start[v + 1]; ++k) {
+            if (colors[v] < 0 || colors[v] == colors[graph->list[k]])
+                return false;
+        }
+    }
+    return true;
+}
+
+static int pairCompare(const void *a, const void *b) {
+    const long long x = *(const long long*)a;
+    const long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+/*adjacency as it comes out of sampling the label map: cells that touch only at a corner count as neighbours
+ *too. Four regions meeting in a corner become a clique and the graph is no longer planar, which is what makes
+ *these graphs hard for the solver */
+static bool graphSampled(Graph *graph, const struct Game *game) {
+    const int cols = game->mapWidth / Cell_Size;
+    const int rows = game->mapHeight / Cell_Size;
+    const int *labels = game->labelMap;
+    const int count = game->regionCount;
+
+    long long *pairs = (long long*)malloc((size_t)cols * rows * 4 * sizeof(long long));
+    graph->start = (int*)malloc((count + 1) * sizeof(int));
+    if (!pairs || !graph->start) {
+        fprintf(stderr, "Failed to allocate memory for the sampled adjacency of %d regions\n", count);
+        free(pairs);
+        return false;
+    }
+
+    static const int offsets[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 } };
+    int pairCount = 0;
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            const int a = labels[row * cols + col];
+            for (int o = 0; o < 4; ++o) {
+                const int x = col + offsets[o][0];
+                const int y = row + offsets[o][1];
+                if (x < 0 || x >= cols || y >= rows)
+                    continue;
+
+                const int b = labels[y * cols + x];
+                if (a != b)
+                    pairs[pairCount++] = a < b ? (long long)a * count + b : (long long)b * count + a;
+            }
+        }
+    }
+
+    qsort(pairs, pairCount, sizeof(long long), pairCompare);
+    int unique = 0;
+    for (int i = 0; i < pairCount; ++i) {
+        if (unique == 0 || pairs[unique - 1] != pairs[i])
+            pairs[unique++] = pairs[i];
+    }
+
+    graph->list = (int*)malloc((unique * 2 + 1) * sizeof(int));
+    if (!graph->list) {
+        fprintf(stderr, "Failed to allocate memory for %d sampled neighbour pairs\n", unique);
+        free(pairs);
+        return false;
+    }
+
+    for (int i = 0; i <= count; ++i)
+        graph->start[i] = 0;
+    for (int i = 0; i < unique; ++i) {
+        graph->start[pairs[i] / count + 1]++;
+        graph->start[pairs[i] % count + 1]++;
+    }
+    for (int i = 0; i < count; ++i)
+        graph->start[i + 1] += graph->start[i];
+
+    int *fill = (int*)malloc(count * sizeof(int));
+    if (!fill) {
+        fprintf(stderr, "Failed to allocate memory for %d regions\n", count);
+        free(pairs);
+        return false;
+    }
+    memcpy(fill, graph->start, count * sizeof(int));
+    for (int i = 0; i < unique; ++i) {
+        const int a = (int)(pairs[i] / count);
+        const int b = (int)(pairs[i] % count);
+        graph->list[fill[a]++] = b;
+        graph->list[fill[b]++] = a;
+    }
+
+    free(fill);
+    free(pairs);
+    graph->name = "sampled, corners touch";
+    graph->count = count;
+    return true;
+}
+
+//the serial solver when pool is NULL, else the parallel one on every thread of pool
+static Timing timeSolve(const Graph *graph, ColoringSolver *solver, ColoringParallel *parallel, WorkerPool *pool) {
+    Timing timing = { Coloring_Done, 0.0, 0, { 0, 0, 0, 0.0 }, false };
+    const long long nodeLimit = (long long)graph->count * Nodes_PerRegion;
+
+    while (timing.result != Coloring_NodeLimit && (timing.runs < Min_Runs || timing.seconds < Min_Seconds)) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (pool)
+            timing.result = coloringSolveParallel(parallel, pool, graph->start, graph->list, graph->count, Color_Count,
+                nodeLimit, &timing.stats);
+        else
+            timing.result = coloringSolve(solver, graph->start, graph->list, graph->count, Color_Count, nodeLimit,
+                &timing.stats);
+        timing.seconds += secondsSince(start);
+        timing.runs++;
+    }
+
+    timing.seconds /= timing.runs;
+    timing.proper = timing.result == Coloring_Done && coloringProper(graph, pool ? parallel->colors : solver->colors);
+    return timing;
+}
+
+static void timingPrint(const char *label, const Timing *timing, const double serialSeconds) {
+    printf("  %-10s %14.0f ns/op %7.2fx  %-11s %12lld nodes %10lld backtracks  (%d ops)\n", label,
+        timing->seconds * 1e9, serialSeconds / timing->seconds, resultName(timing->result), timing->stats.nodes,
+        timing->stats.backtracks, timing->runs);
+}
+
+/*the serial solver against the parallel one at every thread count, speedup is serial time over parallel time.
+ *A coloring that is not proper or a parallel answer that disagrees with the serial one fails the benchmark */
+static bool benchGraph(const Graph *graph, const int *threadCounts, const int threadCountCount) {
+    ColoringSolver solver = {0};
+    ColoringParallel parallel = {0};
+
+    int edges = graph->start[graph->count] / 2;
+    printf("%s, %d regions, %d neighbour pairs\n", graph->name, graph->count, edges);
+
+    const Timing serial = timeSolve(graph, &solver, NULL, NULL);
+    timingPrint("serial", &serial, serial.seconds);
+    bool ok = serial.result != Coloring_Done || serial.proper;
+
+    for (int i = 0; i < threadCountCount && ok; ++i) {
+        WorkerPool pool;
+        workerPoolStart(&pool, threadCounts[i] - 1);
+
+        char label[32];
+        snprintf(label, sizeof(label), "%d threads", workerPoolSize(&pool));
+        const Timing timing = timeSolve(graph, NULL, &parallel, &pool);
+        timingPrint(label, &timing, serial.seconds);
+        workerPoolStop(&pool);
+
+        if (timing.result == Coloring_Done && !timing.proper) {
+            fprintf(stderr, "The parallel coloring has neighbours that share a color\n");
+            ok = false;
+        }
+        //a node limit can hit either side first, the other answers have to agree
+        if (timing.result != Coloring_NodeLimit && serial.result != Coloring_NodeLimit &&
+            timing.result != serial.result) {
+            fprintf(stderr, "The parallel solver says %s, the serial one %s\n", resultName(timing.result),
+                resultName(serial.result));
+            ok = false;
+        }
+    }
+    printf("\n");
+
+    coloringParallelFree(&parallel);
+    coloringSolverFree(&solver);
+    return ok;
+}
+
+//one generated map: its triangulated adjacency as the game uses it, then the sampled one
+static bool benchMap(struct Game *game, const int count, const int *threadCounts, const int threadCountCount) {
+    game->customRegionCount = count;
+    if (!setDifficulty(game, Custom))
+        return false;
+
+    char mapId[MapId_Size];
+    mapIdFormat(game, mapId, sizeof(mapId));
+    printf("map %s\n", mapId);
+
+    Graph triangulated = { "triangulated", game->adjucencyStart, game->adjucencyList, game->regionCount };
+    if (!benchGraph(&triangulated, threadCounts, threadCountCount))
+        return false;
+
+    Graph sampled = { NULL, NULL, NULL, 0 };
+    bool ok = graphSampled(&sampled, game) && benchGraph(&sampled, threadCounts, threadCountCount);
+    free(sampled.start);
+    free(sampled.list);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    static const int defaultCounts[] = { 1000, 10000, 100000 };
+
+    //nothing is shown, the map is only generated to get its adjacency
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    //usage: Solver_Benchmark [--threads MAX] [WIDTHxHEIGHT] [REGIONS ...]
+    int maxThreads = SDL_GetCPUCount();
+    int width = 1920;
+    int height = 1080;
+    int counts[16];
+    int countCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            maxThreads = atoi(argv[++i]);
+        } else if (strchr(argv[i], 'x')) {
+            sscanf(argv[i], "%dx%d", &width, &height);
+        } else if (atoi(argv[i]) > 0 && countCount < 16) {
+            counts[countCount++] = atoi(argv[i]);
+        }
+    }
+    if (maxThreads < 1)
+        maxThreads = 1;
+    if (countCount == 0) {
+        countCount = (int)(sizeof(defaultCounts) / sizeof(defaultCounts[0]));
+        memcpy(counts, defaultCounts, sizeof(defaultCounts));
+    }
+
+    //powers of two up to the maximum, and the maximum itself
+    int threadCounts[32];
+    int threadCountCount = 0;
+    for (int t = 1; t < maxThreads && threadCountCount < 31; t *= 2)
+        threadCounts[threadCountCount++] = t;
+    threadCounts[threadCountCount++] = maxThreads;
+
+    struct Game game = {
+        .mapWidth = width,
+        .mapHeight = height,
+        .labelEngine = LabelEngine_Blocks,
+        .difficulty = Custom,
+        .gameState = Game,
+    };
+    if (sdl_initialise(&game)) {
+        game_cleanup(&game);
+        return EXIT_FAILURE;
+    }
+
+    //a fixed seed, every run solves the same maps
+    rngSeed(&game.rng, 12345);
+
+    bool ok = true;
+    for (int i = 0; i < countCount && ok; ++i)
+        ok = benchMap(&game, counts[i], threadCounts, threadCountCount);
+
+    game_cleanup(&game);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,639 @@
+#include "coloring_solver.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//nodes a thread of a parallel solve colors between looks at the shared state
+#define Coloring_NodeBatch 256
+
+/*the first length picks of a search are fixed to these vertices and colors, the last one is the color that was
+ *split off */
+struct ColoringTask {
+    int length;
+    int *vertices;
+    Uint8 *colors;
+};
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+//vertices of one bucket are a doubly linked list, the key is saturation first and degree second
+static void bucketInsert(ColoringSolver *solver, const int v, const int key) {
+    solver->key[v] = key;
+    solver->prev[v] = -1;
+    solver->next[v] = solver->head[key];
+    if (solver->head[key] >= 0)
+        solver->prev[solver->head[key]] = v;
+    solver->head[key] = v;
+
+    if (key > solver->top)
+        solver->top = key;
+}
+
+static void bucketRemove(ColoringSolver *solver, const int v) {
+    const int key = solver->key[v];
+    if (solver->prev[v] >= 0)
+        solver->next[solver->prev[v]] = solver->next[v];
+    else
+        solver->head[key] = solver->next[v];
+    if (solver->next[v] >= 0)
+        solver->prev[solver->next[v]] = solver->prev[v];
+    solver->key[v] = -1;
+}
+
+/*give v color c, or take it back when c is negative. Only a neighbour whose first (last) neighbour of
+ *that color comes (goes) changes its saturation and bucket */
+static void colorChange(ColoringSolver *solver, const ColoringGraph *graph, const int v, const int c) {
+    const int color = c >= 0 ? c : solver->colors[v];
+    const int step = c >= 0 ? 1 : -1;
+    solver->colors[v] = c;
+    solver->stackColors[color] += step;
+
+    for (int k = graph->start[v]; k < graph->start[v + 1]; ++k) {
+        const int n = graph->list[k];
+        int *count = &solver->colorCounts[n * graph->colorCount + color];
+        *count += step;
+        if (*count != (step > 0 ? 1 : 0))
+            continue;
+
+        solver->blocked[n] ^= (Uint8)(1 << color);
+        solver->saturation[n] += step;
+        if (solver->key[n] >= 0) {
+            const int degree = solver->key[n] % graph->degreeSpan;
+            bucketRemove(solver, n);
+            bucketInsert(solver, n, solver->saturation[n] * graph->degreeSpan + degree);
+        }
+    }
+}
+
+static ColoringResult solveFinish(const ColoringResult result, ColoringStats *stats, const Uint64 started) {
+    stats->seconds = (double)(SDL_GetPerformanceCounter() - started) / (double)SDL_GetPerformanceFrequency();
+    return result;
+}
+
+//add a level to the conflicts of stack level at, false if the pool can't grow
+static bool conflictAdd(ColoringSolver *solver, const int at, const int level) {
+    int entry = solver->freeEntries;
+    if (entry >= 0) {
+        solver->freeEntries = solver->entryNext[entry];
+    } else {
+        if (solver->entryCount == solver->entryCapacity) {
+            const int grown = solver->entryCapacity > 0 ? solver->entryCapacity * 2 : 1024;
+            if (!resizeArray((void**)&solver->entryLevel, grown, sizeof(int)) ||
+                !resizeArray((void**)&solver->entryNext, grown, sizeof(int)))
+                return false;
+            solver->entryCapacity = grown;
+        }
+        entry = solver->entryCount++;
+    }
+
+    solver->entryLevel[entry] = level;
+    solver->entryNext[entry] = -1;
+    if (solver->conflictHead[at] < 0)
+        solver->conflictHead[at] = entry;
+    else
+        solver->entryNext[solver->conflictTail[at]] = entry;
+    solver->conflictTail[at] = entry;
+    return true;
+}
+
+//give the whole conflict list of a level to the free list
+static void conflictClear(ColoringSolver *solver, const int at) {
+    if (solver->conflictHead[at] < 0)
+        return;
+
+    solver->entryNext[solver->conflictTail[at]] = solver->freeEntries;
+    solver->freeEntries = solver->conflictHead[at];
+    solver->conflictHead[at] = -1;
+}
+
+/*free one of the colors in wanted for v by swapping two colors on the shortest Kempe chain kempe_repair finds.
+ *Returns false if no pair of colors has a chain of at most Kempe_MaxChain vertices.
+ *A swap may also recolor the fixed picks of a parallel task. Tasks then overlap, but a search with repair only
+ *counts when it finds a coloring */
+static bool kempeFree(ColoringSolver *solver, const ColoringGraph *graph, const int v, const Uint8 wanted) {
+    KempeMove move;
+    if (!kempeRepairFind(&solver->kempe, graph->start, graph->list, solver->colors, sizeof(int), graph->count,
+        graph->colorCount, wanted, v, -1, &move) || move.chainLength == 0)
+        return false;
+
+    for (int q = 0; q < move.chainLength; ++q) {
+        const int w = solver->kempe.chain[q];
+        const int other = solver->colors[w] == move.chainA ? move.chainB : move.chainA;
+        colorChange(solver, graph, w, -1);
+        colorChange(solver, graph, w, other);
+        solver->stackTried[solver->level[w]] |= (Uint8)(1 << other);
+    }
+    return true;
+}
+
+//room for a solve of the graph in every buffer, false if memory ran out
+static bool solverReserve(ColoringSolver *solver, const ColoringGraph *graph) {
+    const int count = graph->count;
+    if (count > solver->vertexCapacity) {
+        if (!resizeArray((void**)&solver->colors, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->saturation, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->blocked, count, sizeof(Uint8)) ||
+            !resizeArray((void**)&solver->key, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->next, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->prev, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->stackVertex, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->stackTried, count, sizeof(Uint8)) ||
+            !resizeArray((void**)&solver->stackAllowed, count, sizeof(Uint8)) ||
+            !resizeArray((void**)&solver->level, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->conflictHead, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->conflictTail, count, sizeof(int)) ||
+            !resizeArray((void**)&solver->colorCounts, (size_t)count * Coloring_MaxColors, sizeof(int)))
+            return false;
+        solver->vertexCapacity = count;
+    }
+
+    const int buckets = (graph->colorCount + 1) * graph->degreeSpan;
+    if (buckets > solver->bucketCapacity) {
+        if (!resizeArray((void**)&solver->head, buckets, sizeof(int)))
+            return false;
+        solver->bucketCapacity = buckets;
+    }
+    return true;
+}
+
+static ColoringTask *taskCreate(const int length) {
+    ColoringTask *task = (ColoringTask*)malloc(sizeof(ColoringTask) + (size_t)length * (sizeof(int) + sizeof(Uint8)));
+    if (!task)
+        return NULL;
+
+    task->length = length;
+    task->vertices = (int*)(task + 1);
+    task->colors = (Uint8*)(task->vertices + length);
+    return task;
+}
+
+static bool dequePush(ColoringDeque *deque, ColoringTask *task) {
+    SDL_AtomicLock(&deque->lock);
+    const bool room = deque->bottom - deque->top < Coloring_DequeSize;
+    if (room)
+        deque->items[deque->bottom++ % Coloring_DequeSize] = task;
+    SDL_AtomicUnlock(&deque->lock);
+    return room;
+}
+
+//the newest task for the owner, the oldest one for a thief
+static ColoringTask *dequePop(ColoringDeque *deque, const bool steal) {
+    ColoringTask *task = NULL;
+    SDL_AtomicLock(&deque->lock);
+    if (deque->bottom > deque->top)
+        task = steal ? deque->items[deque->top++ % Coloring_DequeSize] : deque->items[--deque->bottom % Coloring_DequeSize];
+    SDL_AtomicUnlock(&deque->lock);
+    return task;
+}
+
+static bool dequeEmpty(ColoringDeque *deque) {
+    SDL_AtomicLock(&deque->lock);
+    const bool empty = deque->bottom == deque->top;
+    SDL_AtomicUnlock(&deque->lock);
+    return empty;
+}
+
+/*split one untried color of the lowest level that still has one off as a task on the own deque. The levels
+ *between the floor and that one have nothing left to try, so once the search jumps back below it the rest of
+ *the task is done and the floor moves up to it */
+static void taskDonate(ColoringSolver *solver, const ColoringGraph *graph, ColoringParallel *parallel,
+    const int thread, const int depth) {
+    for (int j = solver->floor; j < depth; ++j) {
+        const int v = solver->stackVertex[j];
+
+        //colors the levels below j take away from v
+        Uint8 below = 0;
+        for (int k = graph->start[v]; k < graph->start[v + 1]; ++k) {
+            const int n = graph->list[k];
+            if (solver->colors[n] >= 0 && solver->level[n] < j)
+                below |= (Uint8)(1 << solver->colors[n]);
+        }
+        const Uint8 untried = solver->stackAllowed[j] & ~below & ~solver->stackTried[j];
+        if (!untried)
+            continue;
+
+        int c = 0;
+        while (!(untried >> c & 1))
+            ++c;
+
+        ColoringTask *task = taskCreate(j + 1);
+        if (!task)
+            return;
+        for (int i = 0; i < j; ++i) {
+            task->vertices[i] = solver->stackVertex[i];
+            task->colors[i] = (Uint8)solver->colors[solver->stackVertex[i]];
+        }
+        task->vertices[j] = v;
+        task->colors[j] = (Uint8)c;
+
+        SDL_AtomicAdd(&parallel->outstanding, 1);
+        if (!dequePush(&parallel->deques[thread], task)) {
+            SDL_AtomicAdd(&parallel->outstanding, -1);
+            free(task);
+            return;
+        }
+        solver->stackTried[j] |= (Uint8)(1 << c);
+        solver->floor = j;
+        return;
+    }
+}
+
+/*one DSATUR search, with repair the dead ends try a Kempe swap before jumping back. A swap changes vertices
+ *below the top of the stack behind the back of their conflict lists, so only a search without repair can
+ *tell that there is no coloring.
+ *A task fixes the first picks and the search covers what is below them, a jump back into the fixed picks
+ *means there is no coloring with them. With parallel set, every Coloring_NodeBatch nodes the search stops if
+ *another thread is done and gives work away if one is idle */
+static ColoringResult search(ColoringSolver *solver, const ColoringGraph *graph, const bool repair,
+    const long long nodeLimit, const ColoringTask *task, ColoringParallel *parallel, const int thread,
+    ColoringStats *stats) {
+    const int *start = graph->start;
+    const int *list = graph->list;
+    const int count = graph->count;
+    const int colorCount = graph->colorCount;
+    const int degreeSpan = graph->degreeSpan;
+
+    for (int b = 0; b < (colorCount + 1) * degreeSpan; ++b)
+        solver->head[b] = -1;
+    solver->top = 0;
+    memset(solver->colorCounts, 0, (size_t)count * colorCount * sizeof(int));
+    solver->entryCount = 0;
+    solver->freeEntries = -1;
+
+    //inserted backwards, so among equal keys the lowest index comes out first
+    for (int v = count - 1; v >= 0; --v) {
+        solver->colors[v] = -1;
+        solver->saturation[v] = 0;
+        solver->blocked[v] = 0;
+        bucketInsert(solver, v, start[v + 1] - start[v]);
+    }
+    for (int c = 0; c < colorCount; ++c)
+        solver->stackColors[c] = 0;
+
+    const Uint8 allColors = (Uint8)((1 << colorCount) - 1);
+    int depth = 0;
+    if (task) {
+        for (; depth < task->length; ++depth) {
+            const int v = task->vertices[depth];
+            bucketRemove(solver, v);
+            solver->stackVertex[depth] = v;
+            solver->stackTried[depth] = allColors;
+            solver->stackAllowed[depth] = allColors;
+            solver->level[v] = depth;
+            solver->conflictHead[depth] = -1;
+            colorChange(solver, graph, v, task->colors[depth]);
+        }
+    }
+    solver->floor = depth;
+
+    long long checked = stats->nodes;
+    while (depth < count) {
+        if (parallel) {
+            if (stats->nodes - checked >= Coloring_NodeBatch) {
+                checked += Coloring_NodeBatch;
+                const long long batches = SDL_AtomicAdd(&parallel->nodeBatches, 1) + 1;
+                if (nodeLimit > 0 && batches * Coloring_NodeBatch >= nodeLimit)
+                    SDL_AtomicSet(&parallel->stop, 1);
+                if (SDL_AtomicGet(&parallel->stop) || SDL_AtomicGet(&parallel->found))
+                    return Coloring_NodeLimit;
+                if (SDL_AtomicGet(&parallel->idle) > 0 && dequeEmpty(&parallel->deques[thread]))
+                    taskDonate(solver, graph, parallel, thread, depth);
+            }
+        } else if (nodeLimit > 0 && stats->nodes >= nodeLimit) {
+            return Coloring_NodeLimit;
+        }
+
+        while (solver->head[solver->top] < 0)
+            --solver->top;
+        const int picked = solver->head[solver->top];
+        bucketRemove(solver, picked);
+        solver->stackVertex[depth] = picked;
+        solver->stackTried[depth] = 0;
+        solver->level[picked] = depth;
+        solver->conflictHead[depth] = -1;
+
+        //colors nobody below has yet are interchangeable, so only the first of them is tried
+        Uint8 used = 0;
+        for (int c = 0; c < colorCount; ++c) {
+            if (solver->stackColors[c] > 0)
+                used |= (Uint8)(1 << c);
+        }
+        solver->stackAllowed[depth] = (Uint8)((used | (~used & (used + 1))) & allColors);
+        ++depth;
+
+        //color the vertex on top of the stack, on a dead end jump back to the deepest conflict and try its next color
+        for (;;) {
+            const int at = depth - 1;
+            const int v = solver->stackVertex[at];
+            const Uint8 options = solver->stackAllowed[at] & ~solver->blocked[v] & ~solver->stackTried[at];
+            if (options) {
+                int c = 0;
+                while (!(options >> c & 1))
+                    ++c;
+                solver->stackTried[at] |= (Uint8)(1 << c);
+                colorChange(solver, graph, v, c);
+                stats->nodes++;
+                break;
+            }
+
+            //a color already tried here is not worth freeing
+            if (repair && kempeFree(solver, graph, v,
+                (Uint8)(solver->blocked[v] & solver->stackAllowed[at] & ~solver->stackTried[at]))) {
+                stats->kempeSwaps++;
+                continue;
+            }
+
+            //the latest neighbour holding a color is what took it away
+            int culprit[Coloring_MaxColors];
+            for (int c = 0; c < colorCount; ++c)
+                culprit[c] = -1;
+            for (int k = start[v]; k < start[v + 1]; ++k) {
+                const int n = list[k];
+                const int c = solver->colors[n];
+                if (c >= 0 && (culprit[c] < 0 || solver->level[n] > culprit[c]))
+                    culprit[c] = solver->level[n];
+            }
+            for (int c = 0; c < colorCount; ++c) {
+                if (culprit[c] >= 0 && !conflictAdd(solver, at, culprit[c]))
+                    return Coloring_NoMemory;
+            }
+            //the colors left out depend on what the level right below took
+            if (solver->stackAllowed[at] != allColors && at > 0 && !conflictAdd(solver, at, at - 1))
+                return Coloring_NoMemory;
+
+            int target = -1;
+            for (int e = solver->conflictHead[at]; e >= 0; e = solver->entryNext[e]) {
+                if (solver->entryLevel[e] > target)
+                    target = solver->entryLevel[e];
+            }
+            if (target < solver->floor)
+                return Coloring_Impossible;
+
+            //the conflicts of this level, except the target itself, become conflicts of the target
+            int *link = &solver->conflictHead[at];
+            int last = -1;
+            while (*link >= 0) {
+                const int e = *link;
+                if (solver->entryLevel[e] == target) {
+                    *link = solver->entryNext[e];
+                    solver->entryNext[e] = solver->freeEntries;
+                    solver->freeEntries = e;
+                } else {
+                    last = e;
+                    link = &solver->entryNext[e];
+                }
+            }
+            if (solver->conflictHead[at] >= 0) {
+                if (solver->conflictHead[target] < 0)
+                    solver->conflictHead[target] = solver->conflictHead[at];
+                else
+                    solver->entryNext[solver->conflictTail[target]] = solver->conflictHead[at];
+                solver->conflictTail[target] = last;
+                solver->conflictHead[at] = -1;
+            }
+
+            //everything above the target goes back into the buckets uncolored
+            for (int j = at; j > target; --j) {
+                const int w = solver->stackVertex[j];
+                if (solver->colors[w] >= 0)
+                    colorChange(solver, graph, w, -1);
+                conflictClear(solver, j);
+                bucketInsert(solver, w, solver->saturation[w] * degreeSpan + start[w + 1] - start[w]);
+            }
+            depth = target + 1;
+
+            colorChange(solver, graph, solver->stackVertex[target], -1);
+            stats->backtracks++;
+        }
+    }
+
+    return Coloring_Done;
+}
+
+static int degreeSpan(const int *start, const int count) {
+    int maxDegree = 0;
+    for (int v = 0; v < count; ++v) {
+        if (start[v + 1] - start[v] > maxDegree)
+            maxDegree = start[v + 1] - start[v];
+    }
+    return maxDegree + 1;
+}
+
+ColoringResult coloringSolve(ColoringSolver *solver, const int *start, const int *list, const int count,
+    const int colorCount, const long long nodeLimit, ColoringStats *stats) {
+    const Uint64 started = SDL_GetPerformanceCounter();
+    stats->nodes = 0;
+    stats->backtracks = 0;
+    stats->kempeSwaps = 0;
+
+    if (colorCount < 1 || colorCount > Coloring_MaxColors)
+        return solveFinish(Coloring_Impossible, stats, started);
+    if (count <= 0)
+        return solveFinish(Coloring_Done, stats, started);
+
+    const ColoringGraph graph = { start, list, count, colorCount, degreeSpan(start, count) };
+    if (!solverReserve(solver, &graph))
+        return solveFinish(Coloring_NoMemory, stats, started);
+
+    ColoringResult result = search(solver, &graph, true, nodeLimit, NULL, NULL, 0, stats);
+    if (result == Coloring_Impossible && stats->kempeSwaps > 0)
+        result = search(solver, &graph, false, nodeLimit, NULL, NULL, 0, stats);
+    return solveFinish(result, stats, started);
+}
+
+/*one thread of a parallel solve: newest own task first, else the oldest task of another thread. Runs until a
+ *coloring is found, the search is stopped or no task is left anywhere */
+static void parallelThread(void *context, const int thread) {
+    ColoringParallel *parallel = (ColoringParallel*)context;
+    ColoringSolver *solver = &parallel->solvers[thread];
+    ColoringStats *stats = &parallel->threadStats[thread];
+    bool idle = false;
+
+    while (!SDL_AtomicGet(&parallel->found) && !SDL_AtomicGet(&parallel->stop)) {
+        ColoringTask *task = dequePop(&parallel->deques[thread], false);
+        for (int i = 1; !task && i < parallel->threadCount; ++i)
+            task = dequePop(&parallel->deques[(thread + i) % parallel->threadCount], true);
+
+        if (!task) {
+            if (!idle) {
+                idle = true;
+                SDL_AtomicAdd(&parallel->idle, 1);
+            }
+            if (SDL_AtomicGet(&parallel->outstanding) == 0)
+                break;
+            SDL_Delay(0);
+            continue;
+        }
+        if (idle) {
+            idle = false;
+            SDL_AtomicAdd(&parallel->idle, -1);
+        }
+
+        const ColoringResult result = search(solver, &parallel->graph, parallel->repair, parallel->nodeLimit, task,
+            parallel, thread, stats);
+        if (result == Coloring_Done && SDL_AtomicCAS(&parallel->found, 0, 1)) {
+            memcpy(parallel->colors, solver->colors, (size_t)parallel->graph.count * sizeof(int));
+        } else if (result == Coloring_NoMemory) {
+            SDL_AtomicSet(&parallel->noMemory, 1);
+            SDL_AtomicSet(&parallel->stop, 1);
+        }
+
+        free(task);
+        SDL_AtomicAdd(&parallel->outstanding, -1);
+    }
+
+    if (idle)
+        SDL_AtomicAdd(&parallel->idle, -1);
+}
+
+//one search over the whole tree, it starts as a single task on the first thread
+static ColoringResult parallelSearch(ColoringParallel *parallel, WorkerPool *pool, const bool repair,
+    ColoringStats *stats) {
+    ColoringTask *root = taskCreate(0);
+    if (!root)
+        return Coloring_NoMemory;
+
+    parallel->repair = repair;
+    for (int t = 0; t < parallel->threadCount; ++t) {
+        parallel->deques[t].top = 0;
+        parallel->deques[t].bottom = 0;
+        parallel->deques[t].lock = 0;
+        parallel->threadStats[t].nodes = 0;
+        parallel->threadStats[t].backtracks = 0;
+        parallel->threadStats[t].kempeSwaps = 0;
+    }
+    dequePush(&parallel->deques[0], root);
+    SDL_AtomicSet(&parallel->outstanding, 1);
+    SDL_AtomicSet(&parallel->idle, 0);
+    SDL_AtomicSet(&parallel->found, 0);
+    SDL_AtomicSet(&parallel->stop, 0);
+    SDL_AtomicSet(&parallel->noMemory, 0);
+
+    workerPoolRun(pool, parallelThread, parallel, parallel->threadCount);
+
+    //tasks nobody got to before the search stopped
+    for (int t = 0; t < parallel->threadCount; ++t) {
+        ColoringTask *task;
+        while ((task = dequePop(&parallel->deques[t], false)) != NULL)
+            free(task);
+        stats->nodes += parallel->threadStats[t].nodes;
+        stats->backtracks += parallel->threadStats[t].backtracks;
+        stats->kempeSwaps += parallel->threadStats[t].kempeSwaps;
+    }
+
+    if (SDL_AtomicGet(&parallel->found))
+        return Coloring_Done;
+    if (SDL_AtomicGet(&parallel->noMemory))
+        return Coloring_NoMemory;
+    if (SDL_AtomicGet(&parallel->stop))
+        return Coloring_NodeLimit;
+    return Coloring_Impossible;
+}
+
+ColoringResult coloringSolveParallel(ColoringParallel *parallel, WorkerPool *pool, const int *start, const int *list,
+    const int count, const int colorCount, const long long nodeLimit, ColoringStats *stats) {
+    const Uint64 started = SDL_GetPerformanceCounter();
+    stats->nodes = 0;
+    stats->backtracks = 0;
+    stats->kempeSwaps = 0;
+
+    if (colorCount < 1 || colorCount > Coloring_MaxColors)
+        return solveFinish(Coloring_Impossible, stats, started);
+    if (count <= 0)
+        return solveFinish(Coloring_Done, stats, started);
+
+    const int threadCount = workerPoolSize(pool);
+    if (threadCount > parallel->threadCapacity) {
+        if (!resizeArray((void**)&parallel->solvers, threadCount, sizeof(ColoringSolver)) ||
+            !resizeArray((void**)&parallel->deques, threadCount, sizeof(ColoringDeque)) ||
+            !resizeArray((void**)&parallel->threadStats, threadCount, sizeof(ColoringStats)))
+            return solveFinish(Coloring_NoMemory, stats, started);
+        memset(parallel->solvers + parallel->threadCapacity, 0,
+            (size_t)(threadCount - parallel->threadCapacity) * sizeof(ColoringSolver));
+        parallel->threadCapacity = threadCount;
+    }
+    if (count > parallel->colorCapacity) {
+        if (!resizeArray((void**)&parallel->colors, count, sizeof(int)))
+            return solveFinish(Coloring_NoMemory, stats, started);
+        parallel->colorCapacity = count;
+    }
+
+    const ColoringGraph graph = { start, list, count, colorCount, degreeSpan(start, count) };
+    for (int t = 0; t < threadCount; ++t) {
+        if (!solverReserve(&parallel->solvers[t], &graph))
+            return solveFinish(Coloring_NoMemory, stats, started);
+    }
+    parallel->graph = graph;
+    parallel->nodeLimit = nodeLimit;
+    parallel->threadCount = threadCount;
+    SDL_AtomicSet(&parallel->nodeBatches, 0);
+
+    ColoringResult result = parallelSearch(parallel, pool, true, stats);
+    if (result == Coloring_Impossible && stats->kempeSwaps > 0)
+        result = parallelSearch(parallel, pool, false, stats);
+    return solveFinish(result, stats, started);
+}
+
+void coloringSolverFree(ColoringSolver *solver) {
+    free(solver->colors);
+    free(solver->colorCounts);
+    free(solver->blocked);
+    free(solver->saturation);
+    free(solver->key);
+    free(solver->next);
+    free(solver->prev);
+    free(solver->head);
+    free(solver->stackVertex);
+    free(solver->stackTried);
+    free(solver->stackAllowed);
+    free(solver->level);
+    free(solver->conflictHead);
+    free(solver->conflictTail);
+    free(solver->entryLevel);
+    free(solver->entryNext);
+    kempeRepairFree(&solver->kempe);
+
+    solver->colors = NULL;
+    solver->colorCounts = NULL;
+    solver->blocked = NULL;
+    solver->saturation = NULL;
+    solver->key = NULL;
+    solver->next = NULL;
+    solver->prev = NULL;
+    solver->head = NULL;
+    solver->stackVertex = NULL;
+    solver->stackTried = NULL;
+    solver->stackAllowed = NULL;
+    solver->level = NULL;
+    solver->conflictHead = NULL;
+    solver->conflictTail = NULL;
+    solver->entryLevel = NULL;
+    solver->entryNext = NULL;
+    solver->vertexCapacity = 0;
+    solver->bucketCapacity = 0;
+    solver->entryCount = 0;
+    solver->entryCapacity = 0;
+}
+
+void coloringParallelFree(ColoringParallel *parallel) {
+    for (int t = 0; t < parallel->threadCapacity; ++t)
+        coloringSolverFree(&parallel->solvers[t]);
+    free(parallel->solvers);
+    free(parallel->deques);
+    free(parallel->threadStats);
+    free(parallel->colors);
+
+    parallel->solvers = NULL;
+    parallel->deques = NULL;
+    parallel->threadStats = NULL;
+    parallel->colors = NULL;
+    parallel->threadCapacity = 0;
+    parallel->colorCapacity = 0;
+}
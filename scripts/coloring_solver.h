@@ -0,0 +1,138 @@
+#ifndef COLORING_SOLVER_H
+#define COLORING_SOLVER_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "kempe_repair.h"
+#include "worker_pool.h"
+
+//colors are kept as bits of one byte
+#define Coloring_MaxColors 8
+
+//tasks one thread of a parallel solve can hold, a full deque stops it from giving work away
+#define Coloring_DequeSize 64
+
+typedef enum {
+    Coloring_Done, // every vertex has a color, no neighbours share one
+    Coloring_Impossible, // the graph can't be colored with that many colors
+    Coloring_NodeLimit, // gave up after the node limit
+    Coloring_NoMemory,
+}ColoringResult;
+
+typedef struct {
+    long long nodes; // colors given to a vertex, including the ones taken back
+    long long backtracks; // jumps back to an earlier vertex
+    long long kempeSwaps; // dead ends repaired by swapping two colors on a chain
+    double seconds;
+} ColoringStats;
+
+/*DSATUR coloring with backtracking. The next vertex is the one with the most different colors among its
+ *neighbours (saturation), then the one with the most neighbours. Vertices wait in buckets by that key, so
+ *picking one and updating the neighbours of a colored vertex costs O(1) each, and both are undone the same
+ *way on backtracking.
+ *A vertex with no color left does not go back just one step. Every stack level keeps the levels that took
+ *colors away from it (its conflicts) and the search jumps back to the deepest of them, everything in between
+ *had nothing to do with the dead end.
+ *On planar maps of ten thousand regions that alone still gets stuck: a dead end can need a color change far
+ *away. So a dead end first tries a Kempe chain swap, which frees a color for the vertex in time linear in the
+ *chain, and only jumps back if no swap works. Swaps make the conflict lists inexact, so when that search
+ *runs out of options a plain one decides if there is no coloring. Buffers are kept between solves and only
+ *grow */
+typedef struct {
+    int *colors; // result, color of every vertex, -1 while it has none
+    int *colorCounts; // [v * colorCount + c], neighbours of v with color c
+    Uint8 *blocked; // bit c is set while a neighbour of v has color c
+    int *saturation;
+    int vertexCapacity;
+
+    int *key; // bucket of every vertex, -1 while it is not waiting in one
+    int *next;
+    int *prev;
+    int *head; // first vertex of every bucket
+    int bucketCapacity;
+    int top; // no bucket above this one holds a vertex
+
+    int *stackVertex; // colored vertices in the order they were picked
+    Uint8 *stackTried; // colors already tried for them
+    Uint8 *stackAllowed; // colors they may take, of the colors unused below only the first
+    int *level; // stack level of every vertex on the stack
+    int stackColors[Coloring_MaxColors]; // colored vertices per color, only vertices on the stack have one
+    int floor; // levels below it are fixed by the task of a parallel solve
+
+    KempeRepair kempe; // chain search of the dead ends
+
+    //conflicts of every stack level as a list of levels, entries come from a pool with a free list
+    int *conflictHead;
+    int *conflictTail;
+    int *entryLevel;
+    int *entryNext;
+    int entryCount;
+    int entryCapacity;
+    int freeEntries;
+} ColoringSolver;
+
+/*color count vertices so that no neighbours share a color. The neighbours of vertex i are
+ *list[start[i] .. start[i + 1]), every edge has to be listed from both sides. colorCount goes up to
+ *Coloring_MaxColors. nodeLimit stops the search after that many nodes, 0 means no limit. On Coloring_Done the
+ *colors are in solver->colors */
+ColoringResult coloringSolve(ColoringSolver *solver, const int *start, const int *list, int count, int colorCount,
+    long long nodeLimit, ColoringStats *stats);
+
+void coloringSolverFree(ColoringSolver *solver);
+
+//the graph of a solve, degreeSpan is one more than the highest degree
+typedef struct {
+    const int *start;
+    const int *list;
+    int count;
+    int colorCount;
+    int degreeSpan;
+} ColoringGraph;
+
+typedef struct ColoringTask ColoringTask;
+
+//tasks of one thread, the owner works at the bottom and thieves take from the top
+typedef struct {
+    ColoringTask *items[Coloring_DequeSize];
+    int top;
+    int bottom;
+    SDL_SpinLock lock;
+} ColoringDeque;
+
+/*the same search spread over the threads of a worker pool. A task is a prefix of fixed picks and covers the
+ *whole search tree below it. A thread works on its own deque and steals the oldest task of another one when it
+ *runs dry. While some thread is idle, a busy one splits off the untried colors of its lowest open level as a new
+ *task, so the big subtrees near the root get handed out first. The first coloring found is kept and every
+ *thread stops at its next check */
+typedef struct {
+    ColoringSolver *solvers; // one per thread
+    ColoringDeque *deques;
+    ColoringStats *threadStats;
+    int threadCapacity;
+
+    int *colors; // result, copied from the thread that found it
+    int colorCapacity;
+
+    //input of the current solve
+    ColoringGraph graph;
+    bool repair;
+    long long nodeLimit;
+    int threadCount;
+
+    SDL_atomic_t outstanding; // tasks queued or being worked on
+    SDL_atomic_t idle; // threads looking for a task
+    SDL_atomic_t found;
+    SDL_atomic_t stop; // node limit hit or memory ran out
+    SDL_atomic_t noMemory;
+    SDL_atomic_t nodeBatches; // nodes of all threads so far, in batches
+} ColoringParallel;
+
+/*coloringSolve on every thread of pool. Takes the same arguments and gives the same kind of result, the
+ *coloring found can differ between runs. On Coloring_Done the colors are in parallel->colors */
+ColoringResult coloringSolveParallel(ColoringParallel *parallel, WorkerPool *pool, const int *start, const int *list,
+    int count, int colorCount, long long nodeLimit, ColoringStats *stats);
+
+void coloringParallelFree(ColoringParallel *parallel);
+
+#endif
@@ -0,0 +1,531 @@
+#include "delaunay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//biggest rectangle side the 64 bit in-circle test is exact for, mirrored coordinates span three sides
+#define Delaunay_NarrowSide 8192
+
+//marks a triangle slot that sits in the free list
+#define Delaunay_Dead (-2)
+
+//resize an array to exactly needed elements
+static bool resizeArray(void **array, const int needed, const size_t elementSize) {
+    void *memory = realloc(*array, (size_t)needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+//grow an array to at least needed elements, the capacity is doubled to keep reallocations rare
+static bool growArray(void **array, int *capacity, const int needed, const size_t elementSize) {
+    if (needed <= *capacity)
+        return true;
+
+    int grown = *capacity > 0 ? *capacity : 16;
+    while (grown < needed)
+        grown *= 2;
+
+    void *memory = realloc(*array, (size_t)grown * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    *capacity = grown;
+    return true;
+}
+
+//> 0 if c is to the left of a->b, < 0 to the right, 0 on the line
+static long long orient(const Delaunay *d, const int a, const int b, const int c) {
+    const long long abx = d->x[b] - d->x[a];
+    const long long aby = d->y[b] - d->y[a];
+    const long long acx = d->x[c] - d->x[a];
+    const long long acy = d->y[c] - d->y[a];
+    return abx * acy - aby * acx;
+}
+
+//sign of the in-circle determinant, > 0 if p is strictly inside the circle through the ccw triangle a, b, c
+static int incircle(const Delaunay *d, const int a, const int b, const int c, const int p) {
+    const long long adx = d->x[a] - d->x[p], ady = d->y[a] - d->y[p];
+    const long long bdx = d->x[b] - d->x[p], bdy = d->y[b] - d->y[p];
+    const long long cdx = d->x[c] - d->x[p], cdy = d->y[c] - d->y[p];
+
+    const long long alift = adx * adx + ady * ady;
+    const long long blift = bdx * bdx + bdy * bdy;
+    const long long clift = cdx * cdx + cdy * cdy;
+
+    const long long bc = bdx * cdy - cdx * bdy;
+    const long long ca = cdx * ady - adx * cdy;
+    const long long ab = adx * bdy - bdx * ady;
+
+#ifdef __SIZEOF_INT128__
+    if (d->wide) {
+        const __int128 det = (__int128)alift * bc + (__int128)blift * ca + (__int128)clift * ab;
+        return det > 0 ? 1 : det < 0 ? -1 : 0;
+    }
+#endif
+
+    const long long det = alift * bc + blift * ca + clift * ab;
+    return det > 0 ? 1 : det < 0 ? -1 : 0;
+}
+
+static int ghostPosition(const DelaunayTriangle *t) {
+    for (int k = 0; k < 3; ++k) {
+        if (t->v[k] == Delaunay_Ghost)
+            return k;
+    }
+    return -1;
+}
+
+/*is point p inside the circumcircle of triangle t. For a ghost triangle standing on hull edge a->b that means
+ *p is outside the hull behind that edge, or exactly on the edge between a and b */
+static bool inConflict(const Delaunay *d, const int t, const int p) {
+    const DelaunayTriangle *tri = &d->triangles[t];
+    const int g = ghostPosition(tri);
+
+    if (g < 0)
+        return incircle(d, tri->v[0], tri->v[1], tri->v[2], p) > 0;
+
+    const int a = tri->v[(g + 1) % 3];
+    const int b = tri->v[(g + 2) % 3];
+    const long long side = orient(d, a, b, p);
+    if (side != 0)
+        return side > 0;
+
+    //collinear with the hull edge, only a point strictly between a and b is in conflict
+    const long long dot = (long long)(d->x[p] - d->x[a]) * (d->x[p] - d->x[b]) +
+        (long long)(d->y[p] - d->y[a]) * (d->y[p] - d->y[b]);
+    return dot < 0;
+}
+
+static int triangleNew(Delaunay *d, const int a, const int b, const int c) {
+    const int t = d->freeCount > 0 ? d->freeTriangles[--d->freeCount] : d->triangleCount++;
+
+    DelaunayTriangle *tri = &d->triangles[t];
+    tri->v[0] = a;
+    tri->v[1] = b;
+    tri->v[2] = c;
+    tri->adj[0] = tri->adj[1] = tri->adj[2] = -1;
+    d->visit[t] = 0;
+    return t;
+}
+
+//index of the edge from -> to in triangle t, -1 if t does not have it
+static int edgeIndex(const DelaunayTriangle *t, const int from, const int to) {
+    for (int k = 0; k < 3; ++k) {
+        if (t->v[(k + 1) % 3] == from && t->v[(k + 2) % 3] == to)
+            return k;
+    }
+    return -1;
+}
+
+/*visibility walk from the last created triangle to the one containing p, or to the ghost triangle
+ *behind the hull edge that sees p */
+static int locate(Delaunay *d, const int p) {
+    int t = d->lastTriangle;
+
+    for (;;) {
+        const DelaunayTriangle *tri = &d->triangles[t];
+        if (ghostPosition(tri) >= 0)
+            return t;
+
+        //random first edge so the walk can not circle forever
+        d->walkRandom ^= d->walkRandom << 13;
+        d->walkRandom ^= d->walkRandom >> 17;
+        d->walkRandom ^= d->walkRandom << 5;
+        const int first = (int)(d->walkRandom % 3);
+
+        int next = -1;
+        for (int i = 0; i < 3; ++i) {
+            const int k = (first + i) % 3;
+            if (orient(d, tri->v[(k + 1) % 3], tri->v[(k + 2) % 3], p) < 0) {
+                next = tri->adj[k];
+                break;
+            }
+        }
+
+        if (next < 0)
+            return t;
+        t = next;
+    }
+}
+
+//add point p: remove every triangle whose circumcircle holds p and connect the hole boundary to p
+static bool insertPoint(Delaunay *d, const int p) {
+    const int start = locate(d, p);
+
+    //same position as an existing vertex, the earlier point keeps the area
+    const DelaunayTriangle *found = &d->triangles[start];
+    for (int k = 0; k < 3; ++k) {
+        const int v = found->v[k];
+        if (v != Delaunay_Ghost && d->x[v] == d->x[p] && d->y[v] == d->y[p])
+            return true;
+    }
+
+    int stackCount = 0;
+    int cavityCount = 0;
+    int boundaryCount = 0;
+
+    ++d->stamp;
+    d->visit[start] = d->stamp;
+    d->stack[stackCount++] = start;
+
+    while (stackCount > 0) {
+        const int t = d->stack[--stackCount];
+
+        if (!growArray((void**)&d->cavity, &d->cavityCapacity, cavityCount + 1, sizeof(int)))
+            return false;
+        d->cavity[cavityCount++] = t;
+
+        for (int k = 0; k < 3; ++k) {
+            const int u = d->triangles[t].adj[k];
+            if (d->visit[u] == d->stamp)
+                continue;
+
+            if (inConflict(d, u, p)) {
+                d->visit[u] = d->stamp;
+                if (!growArray((void**)&d->stack, &d->stackCapacity, stackCount + 1, sizeof(int)))
+                    return false;
+                d->stack[stackCount++] = u;
+            } else {
+                if (!growArray((void**)&d->boundary, &d->boundaryCapacity, (boundaryCount + 1) * 3, sizeof(int)))
+                    return false;
+                d->boundary[boundaryCount * 3] = d->triangles[t].v[(k + 1) % 3];
+                d->boundary[boundaryCount * 3 + 1] = d->triangles[t].v[(k + 2) % 3];
+                d->boundary[boundaryCount * 3 + 2] = u;
+                ++boundaryCount;
+            }
+        }
+    }
+
+    //the cavity slots are reused by the new triangles
+    for (int i = 0; i < cavityCount; ++i) {
+        d->triangles[d->cavity[i]].v[0] = Delaunay_Dead;
+        d->freeTriangles[d->freeCount++] = d->cavity[i];
+    }
+
+    //the ghost vertex is kept in the last slot of the per vertex tables
+    const int ghostSlot = d->pointCount;
+
+    for (int i = 0; i < boundaryCount; ++i) {
+        const int e0 = d->boundary[i * 3];
+        const int e1 = d->boundary[i * 3 + 1];
+        const int outside = d->boundary[i * 3 + 2];
+
+        const int t = triangleNew(d, e0, e1, p);
+        d->triangles[t].adj[2] = outside;
+        d->triangles[outside].adj[edgeIndex(&d->triangles[outside], e1, e0)] = t;
+
+        d->startTri[e0 == Delaunay_Ghost ? ghostSlot : e0] = t;
+        d->endTri[e1 == Delaunay_Ghost ? ghostSlot : e1] = t;
+
+        if (e0 != Delaunay_Ghost && e1 != Delaunay_Ghost)
+            d->lastTriangle = t;
+    }
+
+    //the boundary is a closed loop around p, so edge e1 -> p continues in the triangle starting at e1
+    for (int i = 0; i < boundaryCount; ++i) {
+        const int e0 = d->boundary[i * 3];
+        const int e1 = d->boundary[i * 3 + 1];
+        const int t = d->startTri[e0 == Delaunay_Ghost ? ghostSlot : e0];
+
+        d->triangles[t].adj[0] = d->startTri[e1 == Delaunay_Ghost ? ghostSlot : e1];
+        d->triangles[t].adj[1] = d->endTri[e0 == Delaunay_Ghost ? ghostSlot : e0];
+    }
+
+    return true;
+}
+
+/*first triangle out of three points that are not on one line, plus the three ghost triangles around it.
+ *Returns false if all points are on one line */
+static bool firstTriangle(Delaunay *d, int *a, int *b, int *c) {
+    const int n = d->pointCount;
+    *a = 0;
+    *b = -1;
+    *c = -1;
+
+    for (int i = 1; i < n && *b < 0; ++i) {
+        if (d->x[i] != d->x[*a] || d->y[i] != d->y[*a])
+            *b = i;
+    }
+    if (*b < 0)
+        return false;
+
+    for (int i = 1; i < n && *c < 0; ++i) {
+        if (orient(d, *a, *b, i) != 0)
+            *c = i;
+    }
+    if (*c < 0)
+        return false;
+
+    if (orient(d, *a, *b, *c) < 0) {
+        const int swap = *b;
+        *b = *c;
+        *c = swap;
+    }
+
+    int tris[4];
+    tris[0] = triangleNew(d, *a, *b, *c);
+    tris[1] = triangleNew(d, *b, *a, Delaunay_Ghost);
+    tris[2] = triangleNew(d, *c, *b, Delaunay_Ghost);
+    tris[3] = triangleNew(d, *a, *c, Delaunay_Ghost);
+
+    //link every edge to the triangle holding it in the other direction
+    for (int i = 0; i < 4; ++i) {
+        DelaunayTriangle *t = &d->triangles[tris[i]];
+        for (int k = 0; k < 3; ++k) {
+            const int from = t->v[(k + 1) % 3];
+            const int to = t->v[(k + 2) % 3];
+            for (int j = 0; j < 4; ++j) {
+                if (j != i && edgeIndex(&d->triangles[tris[j]], to, from) >= 0)
+                    t->adj[k] = tris[j];
+            }
+        }
+    }
+
+    d->lastTriangle = tris[0];
+    return true;
+}
+
+//position of cell (x, y) along the hilbert curve through a side*side grid, side is a power of two
+static int hilbertIndex(const int side, int x, int y) {
+    int index = 0;
+    for (int s = side / 2; s > 0; s /= 2) {
+        const int rx = (x & s) > 0;
+        const int ry = (y & s) > 0;
+        index += s * s * ((3 * rx) ^ ry);
+
+        //rotate the quadrant so the curve stays connected
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            const int swap = x;
+            x = y;
+            y = swap;
+        }
+    }
+    return index;
+}
+
+/*insertion order: points are bucketed into a grid and the buckets are visited along a hilbert curve,
+ *so consecutive points are close and every point location walk is short. The points are then renumbered
+ *in that order, which keeps the coordinates touched by one insertion together in memory */
+static void sortPoints(Delaunay *d, const int minX, const int minY, const int spanX, const int spanY) {
+    const int n = d->pointCount;
+
+    //a few points per bucket keeps the counting array small enough for the cache
+    int side = 1;
+    while (side * side * 8 < n)
+        side *= 2;
+
+    const int cells = side * side;
+    const long long longest = spanX > spanY ? spanX : spanY;
+
+    //counting sort by bucket, the stack is borrowed as the key storage
+    int *counts = (int*)calloc((size_t)cells + 1, sizeof(int));
+    if (!counts) {
+        for (int i = 0; i < n; ++i)
+            d->source[i] = i;
+        return;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const int col = (int)((d->x[i] - minX) * side / longest);
+        const int row = (int)((d->y[i] - minY) * side / longest);
+        d->stack[i] = hilbertIndex(side, col, row);
+        counts[d->stack[i] + 1]++;
+    }
+
+    for (int b = 0; b < cells; ++b)
+        counts[b + 1] += counts[b];
+
+    //stable, so an earlier seed always comes before a later seed at the same position
+    for (int i = 0; i < n; ++i)
+        d->source[counts[d->stack[i]]++] = i;
+
+    free(counts);
+
+    /*the points closest to the four corners go first. Their quadrilateral covers almost everything, so later
+     *points are nearly always inside the hull and don't see a long chain of hull edges. Strict comparisons
+     *keep the lowest index among points at the same position */
+    int extreme[4] = { 0, 0, 0, 0 };
+    for (int i = 1; i < n; ++i) {
+        if (d->x[i] + d->y[i] < d->x[extreme[0]] + d->y[extreme[0]]) extreme[0] = i;
+        if (d->x[i] + d->y[i] > d->x[extreme[1]] + d->y[extreme[1]]) extreme[1] = i;
+        if (d->x[i] - d->y[i] < d->x[extreme[2]] - d->y[extreme[2]]) extreme[2] = i;
+        if (d->x[i] - d->y[i] > d->x[extreme[3]] - d->y[extreme[3]]) extreme[3] = i;
+    }
+
+    for (int i = 0; i < n; ++i)
+        d->stack[i] = d->source[i];
+
+    int placed = 0;
+    for (int e = 0; e < 4; ++e) {
+        bool seen = false;
+        for (int f = 0; f < e; ++f)
+            seen = seen || extreme[f] == extreme[e];
+        if (!seen)
+            d->source[placed++] = extreme[e];
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const int p = d->stack[i];
+        if (p != extreme[0] && p != extreme[1] && p != extreme[2] && p != extreme[3])
+            d->source[placed++] = p;
+    }
+
+    //renumber, the per vertex triangle tables are free at this point and hold the copy
+    for (int i = 0; i < n; ++i) {
+        d->startTri[i] = d->x[d->source[i]];
+        d->endTri[i] = d->y[d->source[i]];
+    }
+    for (int i = 0; i < n; ++i) {
+        d->x[i] = d->startTri[i];
+        d->y[i] = d->endTri[i];
+    }
+}
+
+bool delaunayBuild(Delaunay *d, const SDL_Point *points, const size_t stride, const int count,
+    const int width, const int height) {
+    d->pairCount = 0;
+    d->triangleCount = 0;
+    d->freeCount = 0;
+    d->seedCount = count;
+
+    if (count <= 1 || width <= 0 || height <= 0)
+        return true;
+
+    d->wide = width > Delaunay_NarrowSide || height > Delaunay_NarrowSide;
+#ifndef __SIZEOF_INT128__
+    if (d->wide)
+        return false;
+#endif
+
+    //seeds plus their mirrors over the left, right, top and bottom side
+    const int n = count * 5;
+    d->pointCount = n;
+
+    //hull of n points has at most 2n - 5 real triangles and n ghost ones
+    const int maxTriangles = 3 * n + 8;
+
+    if (n > d->pointCapacity) {
+        if (!resizeArray((void**)&d->x, n, sizeof(int)) || !resizeArray((void**)&d->y, n, sizeof(int)) ||
+            !resizeArray((void**)&d->source, n, sizeof(int)))
+            return false;
+        d->pointCapacity = n;
+    }
+
+    //per vertex tables have one more slot for the ghost vertex
+    if (n + 1 > d->vertexCapacity) {
+        if (!resizeArray((void**)&d->startTri, n + 1, sizeof(int)) || !resizeArray((void**)&d->endTri, n + 1, sizeof(int)))
+            return false;
+        d->vertexCapacity = n + 1;
+    }
+
+    if (maxTriangles > d->triangleCapacity) {
+        if (!resizeArray((void**)&d->triangles, maxTriangles, sizeof(DelaunayTriangle)) ||
+            !resizeArray((void**)&d->freeTriangles, maxTriangles, sizeof(int)) ||
+            !resizeArray((void**)&d->visit, maxTriangles, sizeof(int)))
+            return false;
+        d->triangleCapacity = maxTriangles;
+    }
+
+    //the stack doubles as sort key storage for every point
+    if (!growArray((void**)&d->stack, &d->stackCapacity, n, sizeof(int)))
+        return false;
+
+    /*mirrors go over the lines x = -0.5, x = width - 0.5, y = -0.5 and y = height - 0.5, the edges of the pixel
+     *area, so they stay on integer coordinates and never land on a seed */
+    const Uint8 *base = (const Uint8*)points;
+    for (int i = 0; i < count; ++i) {
+        const SDL_Point *p = (const SDL_Point*)(base + i * stride);
+
+        d->x[i] = p->x;
+        d->y[i] = p->y;
+
+        d->x[count + i * 4] = -1 - p->x;
+        d->y[count + i * 4] = p->y;
+        d->x[count + i * 4 + 1] = 2 * width - 1 - p->x;
+        d->y[count + i * 4 + 1] = p->y;
+        d->x[count + i * 4 + 2] = p->x;
+        d->y[count + i * 4 + 2] = -1 - p->y;
+        d->x[count + i * 4 + 3] = p->x;
+        d->y[count + i * 4 + 3] = 2 * height - 1 - p->y;
+    }
+
+    sortPoints(d, -width, -height, 3 * width, 3 * height);
+
+    d->stamp = 0;
+    d->walkRandom = 2463534242u;
+
+    int a, b, c;
+    if (!firstTriangle(d, &a, &b, &c))
+        return true;
+
+    for (int p = 0; p < n; ++p) {
+        if (p == a || p == b || p == c)
+            continue;
+
+        if (!insertPoint(d, p))
+            return false;
+    }
+
+    /*every Delaunay edge between two seeds is a candidate. The cells really share a border unless the four
+     *points around the edge lie on one circle, then the border shrinks to a single point */
+    for (int t = 0; t < d->triangleCount; ++t) {
+        const DelaunayTriangle *tri = &d->triangles[t];
+        if (tri->v[0] == Delaunay_Dead || ghostPosition(tri) >= 0)
+            continue;
+
+        for (int k = 0; k < 3; ++k) {
+            const int vi = tri->v[(k + 1) % 3];
+            const int vj = tri->v[(k + 2) % 3];
+            const int i = d->source[vi];
+            const int j = d->source[vj];
+            if (i >= count || j >= count)
+                continue;
+
+            const DelaunayTriangle *other = &d->triangles[tri->adj[k]];
+            const bool otherGhost = ghostPosition(other) >= 0;
+
+            //each edge is seen from both sides, take it once
+            if (i > j && !otherGhost)
+                continue;
+
+            if (!otherGhost) {
+                const int opposite = other->v[edgeIndex(other, vj, vi)];
+                if (incircle(d, tri->v[k], vi, vj, opposite) == 0)
+                    continue;
+            }
+
+            if (!growArray((void**)&d->pairs, &d->pairCapacity, (d->pairCount + 1) * 2, sizeof(int)))
+                return false;
+            d->pairs[d->pairCount * 2] = i < j ? i : j;
+            d->pairs[d->pairCount * 2 + 1] = i < j ? j : i;
+            ++d->pairCount;
+        }
+    }
+
+    return true;
+}
+
+void delaunayFree(Delaunay *d) {
+    free(d->x);
+    free(d->y);
+    free(d->source);
+    free(d->triangles);
+    free(d->freeTriangles);
+    free(d->visit);
+    free(d->stack);
+    free(d->cavity);
+    free(d->boundary);
+    free(d->startTri);
+    free(d->endTri);
+    free(d->pairs);
+
+    memset(d, 0, sizeof(*d));
+}
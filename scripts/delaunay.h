@@ -0,0 +1,67 @@
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/*one triangle of the triangulation, counter clockwise. adj[k] is the triangle on the other side of the edge
+ *that does not contain v[k]. Triangles outside the convex hull use Delaunay_Ghost as their third vertex */
+typedef struct {
+    int v[3];
+    int adj[3];
+} DelaunayTriangle;
+
+#define Delaunay_Ghost (-1)
+
+/*incremental (Bowyer-Watson) Delaunay triangulation of the region seeds, used to find which regions share a
+ *border. Every seed is mirrored over the four sides of the width*height rectangle before triangulating, which
+ *clips the Voronoi cells of the real seeds to the rectangle. All predicates use exact integer arithmetic.
+ *Buffers are kept between builds and only grow */
+typedef struct {
+    int *x;
+    int *y;
+    int pointCount; // seeds followed by their mirrors
+    int pointCapacity;
+    int seedCount;
+
+    int *source; // seed or mirror index of every vertex, vertices are numbered in insertion order
+
+    DelaunayTriangle *triangles;
+    int triangleCount; // used slots, dead ones are in the free list
+    int triangleCapacity;
+
+    int *freeTriangles;
+    int freeCount;
+
+    int *visit; // per triangle stamp for the cavity search
+    int stamp;
+
+    int *stack;
+    int *cavity;
+    int *boundary; // e0, e1, outside triangle per cavity boundary edge
+    int stackCapacity;
+    int cavityCapacity;
+    int boundaryCapacity;
+
+    int *startTri; // per vertex, new triangle whose boundary edge starts (ends) at the vertex
+    int *endTri;
+    int vertexCapacity;
+
+    int lastTriangle; // a real triangle where the next point location starts
+    Uint32 walkRandom;
+    bool wide; // coordinates too big for 64 bit in-circle tests
+
+    int *pairs; // result: pairs[2k] < pairs[2k + 1] are seeds whose clipped Voronoi cells share a border
+    int pairCount;
+    int pairCapacity;
+} Delaunay;
+
+/*triangulate count seeds lying inside a width*height rectangle and fill pairs with the adjacent ones.
+ *stride is the distance in bytes between two consecutive seed points. A seed equal to an earlier seed owns
+ *no area and gets no pairs. Returns false if memory could not be allocated or the rectangle is too big for
+ *exact arithmetic on this compiler */
+bool delaunayBuild(Delaunay *delaunay, const SDL_Point *points, size_t stride, int count, int width, int height);
+
+void delaunayFree(Delaunay *delaunay);
+
+#endif
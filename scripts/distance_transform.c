@@ -0,0 +1,252 @@
+#include "distance_transform.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+//cell columns per task of the envelope pass
+#define Band_Columns 8
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+static const SDL_Point *pointAt(const DistanceTransform *transform, const int i) {
+    return (const SDL_Point*)(transform->points + (size_t)i * transform->stride);
+}
+
+/*first pass for one seed row: the closest seed of the row for every cell column. Seeds of the row are sorted by x,
+ *so while the columns move right the candidates are the last seed left of the column and the first one right of it */
+static void rowPass(void *context, const int r) {
+    DistanceTransform *transform = (DistanceTransform*)context;
+    const int *seeds = transform->order + transform->rowStart[r];
+    const int seedCount = transform->rowStart[r + 1] - transform->rowStart[r];
+    const int cellSize = transform->cellSize;
+
+    int right = 0; // first seed with x > column center
+    for (int col = 0; col < transform->cols; ++col) {
+        const int x = col * cellSize + cellSize / 2;
+        while (right < seedCount && pointAt(transform, seeds[right])->x <= x)
+            ++right;
+
+        int owner = -1;
+        int distance = INT_MAX;
+        if (right > 0) {
+            owner = seeds[right - 1];
+            distance = x - pointAt(transform, owner)->x;
+        }
+        if (right < seedCount) {
+            const int candidate = seeds[right];
+            const int d = pointAt(transform, candidate)->x - x;
+            if (owner < 0 || d < distance || (d == distance && candidate < owner)) {
+                owner = candidate;
+                distance = d;
+            }
+        }
+
+        const size_t at = (size_t)col * transform->rowCount + r;
+        transform->rowDistance[at] = distance * distance;
+        transform->rowOwner[at] = owner;
+    }
+}
+
+//value of the parabola of seed row r in column table g at pixel row y
+static long long parabolaAt(const DistanceTransform *transform, const int *g, const int r, const int y) {
+    const long long dy = y - transform->rowY[r];
+    return g[r] + dy * dy;
+}
+
+/*second pass for a band of cell columns. Every seed row is a parabola over y, the lower envelope of them gives the
+ *closest seed for every y. Envelope borders are kept as exact fractions. A parabola that only touches the envelope
+ *in one point is kept, so at a border all tied parabolas are still there and the lowest seed index can win */
+static void columnPass(void *context, const int band) {
+    DistanceTransform *transform = (DistanceTransform*)context;
+    const int rowCount = transform->rowCount;
+    const int cellSize = transform->cellSize;
+
+    int *envelope = transform->envelope + (size_t)band * (rowCount + 1);
+    long long *boundNum = transform->boundNum + (size_t)band * (rowCount + 1);
+    long long *boundDen = transform->boundDen + (size_t)band * (rowCount + 1);
+
+    const int colEnd = (band + 1) * Band_Columns < transform->cols ? (band + 1) * Band_Columns : transform->cols;
+    for (int col = band * Band_Columns; col < colEnd; ++col) {
+        const int *g = transform->rowDistance + (size_t)col * rowCount;
+        const int *owner = transform->rowOwner + (size_t)col * rowCount;
+
+        //envelope[0] starts at minus infinity, boundDen 0 marks that
+        int top = 0;
+        envelope[0] = 0;
+        boundNum[0] = -1;
+        boundDen[0] = 0;
+
+        for (int r = 1; r < rowCount; ++r) {
+            const long long fr = g[r] + (long long)transform->rowY[r] * transform->rowY[r];
+            long long num, den;
+            for (;;) {
+                const int v = envelope[top];
+                num = fr - (g[v] + (long long)transform->rowY[v] * transform->rowY[v]);
+                den = 2LL * (transform->rowY[r] - transform->rowY[v]);
+
+                //drop the last parabola while the new one is below it everywhere it was the lowest
+                if (top > 0 && num * boundDen[top] < boundNum[top] * den)
+                    --top;
+                else
+                    break;
+            }
+            ++top;
+            envelope[top] = r;
+            boundNum[top] = num;
+            boundDen[top] = den;
+        }
+
+        int k = 0;
+        for (int row = 0; row < transform->rows; ++row) {
+            const long long y = row * cellSize + cellSize / 2;
+
+            //move to the parabola whose piece holds y, border k + 1 is at boundNum / boundDen
+            while (k < top && boundNum[k + 1] < y * boundDen[k + 1])
+                ++k;
+
+            int best = envelope[k];
+            long long bestValue = parabolaAt(transform, g, best, (int)y);
+
+            //parabolas that start exactly at y tie with the current one
+            for (int j = k + 1; j <= top && boundNum[j] == y * boundDen[j]; ++j) {
+                const int r = envelope[j];
+                const long long value = parabolaAt(transform, g, r, (int)y);
+                if (value < bestValue || (value == bestValue && owner[r] < owner[best])) {
+                    best = r;
+                    bestValue = value;
+                }
+            }
+
+            transform->labels[row * transform->cols + col] = owner[best];
+        }
+    }
+}
+
+bool distanceTransformLabel(DistanceTransform *transform, const SDL_Point *points, const size_t stride,
+    const int count, const int width, const int height, const int cellSize, int *labels, WorkerPool *pool) {
+    const int cols = width / cellSize;
+    const int rows = height / cellSize;
+    if (count <= 0 || cols <= 0 || rows <= 0)
+        return false;
+
+    if (count > transform->seedCapacity) {
+        if (!resizeArray((void**)&transform->order, count, sizeof(int)) ||
+            !resizeArray((void**)&transform->sortScratch, count, sizeof(int)))
+            return false;
+        transform->seedCapacity = count;
+    }
+
+    const int countSize = (width > height ? width : height) + 1;
+    if (countSize > transform->countCapacity) {
+        if (!resizeArray((void**)&transform->counts, countSize, sizeof(int)))
+            return false;
+        transform->countCapacity = countSize;
+    }
+
+    if (height + 1 > transform->rowCapacity) {
+        if (!resizeArray((void**)&transform->rowStart, height + 1, sizeof(int)) ||
+            !resizeArray((void**)&transform->rowY, height, sizeof(int)))
+            return false;
+        transform->rowCapacity = height + 1;
+    }
+
+    transform->points = (const Uint8*)points;
+    transform->stride = stride;
+    transform->cellSize = cellSize;
+    transform->cols = cols;
+    transform->rows = rows;
+    transform->labels = labels;
+
+    //counting sort by x, then a stable counting sort by y gives the seeds row by row and left to right
+    int *counts = transform->counts;
+    for (int i = 0; i <= width; ++i)
+        counts[i] = 0;
+    for (int i = 0; i < count; ++i)
+        counts[pointAt(transform, i)->x + 1]++;
+    for (int i = 0; i < width; ++i)
+        counts[i + 1] += counts[i];
+    for (int i = 0; i < count; ++i)
+        transform->sortScratch[counts[pointAt(transform, i)->x]++] = i;
+
+    for (int i = 0; i <= height; ++i)
+        counts[i] = 0;
+    for (int i = 0; i < count; ++i)
+        counts[pointAt(transform, i)->y + 1]++;
+    for (int i = 0; i < height; ++i)
+        counts[i + 1] += counts[i];
+    for (int i = 0; i < count; ++i) {
+        const int seed = transform->sortScratch[i];
+        transform->order[counts[pointAt(transform, seed)->y]++] = seed;
+    }
+
+    //group the sorted seeds into rows
+    int rowCount = 0;
+    for (int i = 0; i < count; ++i) {
+        const int y = pointAt(transform, transform->order[i])->y;
+        if (rowCount == 0 || transform->rowY[rowCount - 1] != y) {
+            transform->rowStart[rowCount] = i;
+            transform->rowY[rowCount] = y;
+            ++rowCount;
+        }
+    }
+    transform->rowStart[rowCount] = count;
+    transform->rowCount = rowCount;
+
+    const size_t tableSize = (size_t)cols * rowCount;
+    if (tableSize > transform->rowTableCapacity) {
+        if (!resizeArray((void**)&transform->rowDistance, tableSize, sizeof(int)) ||
+            !resizeArray((void**)&transform->rowOwner, tableSize, sizeof(int)))
+            return false;
+        transform->rowTableCapacity = tableSize;
+    }
+
+    const int bands = (cols + Band_Columns - 1) / Band_Columns;
+    const size_t envelopeSize = (size_t)bands * (rowCount + 1);
+    if (envelopeSize > transform->envelopeCapacity) {
+        if (!resizeArray((void**)&transform->envelope, envelopeSize, sizeof(int)) ||
+            !resizeArray((void**)&transform->boundNum, envelopeSize, sizeof(long long)) ||
+            !resizeArray((void**)&transform->boundDen, envelopeSize, sizeof(long long)))
+            return false;
+        transform->envelopeCapacity = envelopeSize;
+    }
+
+    workerPoolRun(pool, rowPass, transform, rowCount);
+    workerPoolRun(pool, columnPass, transform, bands);
+    return true;
+}
+
+void distanceTransformFree(DistanceTransform *transform) {
+    free(transform->order);
+    free(transform->sortScratch);
+    free(transform->counts);
+    free(transform->rowStart);
+    free(transform->rowY);
+    free(transform->rowDistance);
+    free(transform->rowOwner);
+    free(transform->envelope);
+    free(transform->boundNum);
+    free(transform->boundDen);
+
+    transform->order = NULL;
+    transform->sortScratch = NULL;
+    transform->counts = NULL;
+    transform->rowStart = NULL;
+    transform->rowY = NULL;
+    transform->rowDistance = NULL;
+    transform->rowOwner = NULL;
+    transform->envelope = NULL;
+    transform->boundNum = NULL;
+    transform->boundDen = NULL;
+    transform->seedCapacity = 0;
+    transform->countCapacity = 0;
+    transform->rowCapacity = 0;
+    transform->rowTableCapacity = 0;
+    transform->envelopeCapacity = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef DISTANCE_TRANSFORM_H
+#define DISTANCE_TRANSFORM_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "worker_pool.h"
+
+/*exact euclidean distance transform (Felzenszwalb and Huttenlocher) that carries the seed labels along, so the
+ *owner of every cell is found without any nearest seed query. It runs in two separable passes:
+ *  - every pixel row that holds seeds gets, for each cell column, its closest seed in that row
+ *  - every cell column takes the lower envelope of the parabolas g + (y - row)^2 of those rows
+ *The cost grows with the map size and the amount of seed rows, not with the amount of seeds. Ties are broken
+ *towards the lower seed index like a linear scan does, so the result is identical to the nearest seed search.
+ *Buffers are kept between builds and only grow */
+typedef struct {
+    int *order; // seeds sorted by row, then by column
+    int *sortScratch;
+    int *counts;
+    int seedCapacity;
+    int countCapacity;
+
+    int *rowStart; // seed rows, rowStart[r] .. rowStart[r + 1] is a range of order
+    int *rowY;
+    int rowCount;
+    int rowCapacity;
+
+    //closest seed of every seed row for every cell column, column major: [col * rowCount + r]
+    int *rowDistance;
+    int *rowOwner;
+    size_t rowTableCapacity;
+
+    //lower envelope scratch, one slice of rowCount + 1 entries per column band
+    int *envelope;
+    long long *boundNum; // envelope entry k starts at boundNum[k] / boundDen[k]
+    long long *boundDen;
+    size_t envelopeCapacity;
+
+    //input of the current build, read by the worker tasks
+    const Uint8 *points;
+    size_t stride;
+    int cellSize;
+    int cols;
+    int rows;
+    int *labels;
+} DistanceTransform;
+
+/*owner of every cellSize*cellSize cell of a width*height plane, measured from the cell center, written to
+ *labels (width / cellSize columns, row by row). stride is the distance in bytes between two points. Both passes
+ *are split over the pool. Returns false if memory could not be allocated or there are no points */
+bool distanceTransformLabel(DistanceTransform *transform, const SDL_Point *points, size_t stride, int count,
+    int width, int height, int cellSize, int *labels, WorkerPool *pool);
+
+void distanceTransformFree(DistanceTransform *transform);
+
+#endif
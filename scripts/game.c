@@ -0,0 +1,1306 @@
+    #include "game.h"
+
+    #include <limits.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+
+    //cell rows per task when the label map or the whole map is split over the worker threads
+    #define Band_Rows 4
+
+    //side in cells of the tiles the block fill starts from, one tile per task
+    #define Block_Tile 16
+
+    //seeds tied for one cell that the neighbour walk keeps track of, more go to the nearest seed search
+    #define Walk_MaxTies 32
+
+    //autoSolve gives up after this many solver nodes per region
+    #define Solve_NodesPerRegion 100
+
+    //the dots on the region centers are left out above this many regions, they would cover most of the map
+    #define Dots_MaxRegions 2000
+
+    //width in pixels of the borders between the polygons, as wide as the border cells of the label map
+    #define Polygon_BorderWidth ((float)Cell_Size)
+
+    const int DIFF_REGION_COUNTS[] = {
+        5,
+        70,
+        100
+    };
+
+    static bool adjucencyFromPairs(struct Game *game, const int *pairs, int pairCount);
+    static bool adjucencyTriangulate(struct Game *game);
+    static int find_closest_region(const struct Game *game, int x, int y);
+    static int find_closest_region_linear(const struct Game *game, int x, int y);
+    static void regionMarkDirty(struct Game *game, int region);
+    static bool regionsReserve(struct Game *game, int count);
+    static bool regionInConflict(const struct Game *game, int region);
+    static bool regionConflictUpdate(struct Game *game, int region);
+    static void regionPaint(struct Game *game, int region, int color);
+    static void regionAutoFix(struct Game *game, int region);
+    static bool regionMoveFind(struct Game *game, int region, int keep, KempeMove *move);
+    static int sq2(int x, int y);
+    static void labelMapBand(void *context, int band);
+    static void labelMapTile(void *context, int tile);
+    static int blockFill(const struct Game *game, int col0, int row0, int col1, int row1);
+    static int cellLabel(const struct Game *game, int col, int row, int *queries);
+    static void labelMapWalkBand(void *context, int band);
+    static int walkOwner(const struct Game *game, int owner, int x, int y);
+    static void mapPaintBand(void *context, int band);
+    static Uint32 packColor(SDL_Color color);
+    static bool regionColorUpdate(struct Game *game, int region);
+    static void regionFill(const struct Game *game, int region);
+    static SDL_Color unpackColor(Uint32 pixel);
+    static void mapTextureDraw(struct Game *game);
+    static bool mapPolygonsDraw(struct Game *game);
+
+    const SDL_Color RGB_palette[Color_Count] = {
+        {255,   0,   0, 255}, //RED
+        {  0, 255,   0, 255}, //GREEN
+        {  0,   0, 255, 255}, //BLUE
+        {255, 255,   0, 255} //YELLOW
+    };
+
+    //a rectangle of cells composited by the worker threads, Band_Rows rows per task
+    typedef struct {
+        const struct Game *game;
+        SDL_Rect cells;
+    } PaintJob;
+
+    //pythagoras square for finding the distance between the cell and the center of the cell
+    static int sq2(int const x, int const y)
+    {
+        return x * x + y * y;
+    }
+
+    //change difficulty level with region amount, false if there is no memory for that many regions
+    bool setDifficulty(struct Game *game, Difficulty diff)
+    {
+
+        game->difficulty = diff;
+        int count = diff == Custom ? game->customRegionCount : DIFF_REGION_COUNTS[diff];
+
+        //every region needs a pixel of its own
+        const size_t pixels = (size_t)game->mapWidth * (size_t)game->mapHeight;
+        if ((size_t)count > pixels) {
+            count = (int)pixels;
+            printf("Only %d regions fit on the map\n", count);
+        }
+
+        if (!regionsReserve(game, count)) {
+            fprintf(stderr, "Failed to allocate memory for %d regions\n", count);
+            return false;
+        }
+        if (!regionBitsReset(&game->regionBits, count, Color_Count)) {
+            fprintf(stderr, "Failed to allocate memory for the color masks of %d regions\n", count);
+            return false;
+        }
+
+        game->regionCount=count;
+        game->uncoloredCount = count;
+        game->conflictCount = 0;
+        for (int i = 0; i < (count + 31) / 32; ++i)
+            game->conflictBits[i] = 0;
+        if (!game->mapSeedGiven)
+            game->mapSeed = rngNext(&game->rng);
+        game->mapSeedGiven = false;
+        regionsGenerator(game);
+        labelMapBuild(game);
+        adjucencyCheck(game);
+        regionPolygonsBuild(game);
+        game->chosenColor = 0;
+        game->startTimer = SDL_GetTicks();
+        game->winState = false;
+        game->solverUsed = false;
+        game->lastPainted = -1;
+        game->finishTimer  = 0;
+
+        for (int i = 0; i < game->regionCount; ++i)
+            game->regionDirty[i] = false;
+        game->dirtyCount = 0;
+        game->repaintAll = true;
+        return true;
+    }
+
+    /*make room for count regions in every per region array. Storage only grows, so restarts and smaller maps
+     *reuse what was allocated before */
+    static bool regionsReserve(struct Game *game, const int count) {
+        if (count <= game->regionCapacity)
+            return true;
+
+        Region *regions = (Region*)realloc(game->regions, count * sizeof(Region));
+        if (!regions)
+            return false;
+        game->regions = regions;
+
+        SDL_Rect *bounds = (SDL_Rect*)realloc(game->regionBounds, count * sizeof(SDL_Rect));
+        if (!bounds)
+            return false;
+        game->regionBounds = bounds;
+
+        bool *dirty = (bool*)realloc(game->regionDirty, count * sizeof(bool));
+        if (!dirty)
+            return false;
+        game->regionDirty = dirty;
+
+        int *dirtyRegions = (int*)realloc(game->dirtyRegions, count * sizeof(int));
+        if (!dirtyRegions)
+            return false;
+        game->dirtyRegions = dirtyRegions;
+
+        int *start = (int*)realloc(game->adjucencyStart, (count + 1) * sizeof(int));
+        if (!start)
+            return false;
+        game->adjucencyStart = start;
+
+        Uint32 *bits = (Uint32*)realloc(game->conflictBits, (count + 31) / 32 * sizeof(Uint32));
+        if (!bits)
+            return false;
+        game->conflictBits = bits;
+
+        Uint32 *colors = (Uint32*)realloc(game->regionColors, (count + 1) * sizeof(Uint32));
+        if (!colors)
+            return false;
+        game->regionColors = colors;
+
+        SDL_Rect *dots = (SDL_Rect*)realloc(game->regionDots, count * sizeof(SDL_Rect));
+        if (!dots)
+            return false;
+        game->regionDots = dots;
+
+        game->regionCapacity = count;
+        return true;
+    }
+
+    //Quitting routine
+    void game_cleanup(struct Game *game) {
+        if (game->adjucencyStart)
+            free(game->adjucencyStart);
+
+        if (game->adjucencyList)
+            free(game->adjucencyList);
+
+        if (game->regions)
+            free(game->regions);
+
+        seedIndexFree(&game->seedIndex);
+        distanceTransformFree(&game->transform);
+        delaunayFree(&game->delaunay);
+        coloringSolverFree(&game->solver);
+        kempeRepairFree(&game->repair);
+        spanTableFree(&game->spans);
+        voronoiPolygonsFree(&game->polygons);
+        regionBitsFree(&game->regionBits);
+
+        if (game->labelMap)
+            free(game->labelMap);
+
+        if (game->pixelTaken)
+            free(game->pixelTaken);
+
+        if (game->conflictBits)
+            free(game->conflictBits);
+
+        if (game->regionColors)
+            free(game->regionColors);
+
+        if (game->regionDots)
+            free(game->regionDots);
+
+        if (game->paintLabels)
+            free(game->paintLabels);
+
+        workerPoolStop(&game->workers);
+
+        if (game->regionBounds)
+            free(game->regionBounds);
+
+        if (game->regionDirty)
+            free(game->regionDirty);
+
+        if (game->dirtyRegions)
+            free(game->dirtyRegions);
+
+        if (game->mapPixels)
+            free(game->mapPixels);
+
+        if (game->mapTexture)
+            SDL_DestroyTexture(game->mapTexture);
+
+        SDL_DestroyRenderer(game->renderer);
+        SDL_DestroyWindow(game->window);
+        SDL_Quit();
+    }
+
+    /*region of the nearest seed to the pixel, -1 outside the map. The label map alone is not enough: on big maps
+     *some regions own no cell center at all, they could never be painted and the map never won. A seed always
+     *owns its own pixel, so the nearest seed is found by walking the delaunay neighbours from the owner of the
+     *cell: the seed at hand is the nearest one once none of its neighbours is nearer. The owner of the cell
+     *center is that seed or one next to it, so the walk takes a step or none wherever the pixel is, where a walk
+     *from the last pick would take about sqrt(n) steps after a jump across the map. That is also the exact border
+     *the polygons draw, the cells can show the neighbour within a cell of it */
+    int regionAt(const struct Game *game, const int x, const int y) {
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+
+        if (x < 0 || y < 0 || x >= game->mapWidth || y >= game->mapHeight)
+            return -1;
+
+        //pixels past the last whole cell start from the cell next to them
+        const int col = SDL_min(x / Cell_Size, gridCols - 1);
+        const int row = SDL_min(y / Cell_Size, gridRows - 1);
+        const int owner = game->labelMap[row * gridCols + col];
+
+        //the walk needs the neighbours of the triangulation, sampled ones can leave it short of the nearest seed
+        return game->adjucencyTriangulated ? walkOwner(game, owner, x, y) : find_closest_region(game, x, y);
+    }
+
+    /*mouse handling proccess for painting, on a click and while dragging with the button held. The region is
+     *picked by regionAt, so the painted region is always the one drawn under the mouse. With auto-fix on, the
+     *neighbours the new color clashes with are recolored over Kempe chains. False if nothing was painted */
+    bool mouse_input(struct Game *game, const int x, const int y) {
+        const int closest = regionAt(game, x, y);
+        if (closest < 0)
+            return false;
+
+        if (game->regions[closest].colorIndex == game->chosenColor)
+            return false;
+
+        game->lastPainted = closest;
+        regionPaint(game, closest, game->chosenColor);
+        if (game->autoFix)
+            regionAutoFix(game, closest);
+        return true;
+    }
+
+    //give one region a color and keep the counters, conflict bits and dirty regions up to date
+    static void regionPaint(struct Game *game, const int region, const int newColor) {
+        const int oldColor = game->regions[region].colorIndex;
+
+        //only the pairs with the neighbours of the region can change
+        if (oldColor < 0)
+            game->uncoloredCount--;
+
+        for (int k = game->adjucencyStart[region]; k < game->adjucencyStart[region + 1]; ++k) {
+            const int neighbourColor = game->regions[game->adjucencyList[k]].colorIndex;
+            if (oldColor >= 0 && neighbourColor == oldColor)
+                game->conflictCount--;
+            if (neighbourColor == newColor)
+                game->conflictCount++;
+        }
+
+        regionBitsPaint(&game->regionBits, region, oldColor, newColor);
+        game->regions[region].colorIndex = newColor;
+
+        //the region itself and every neighbour whose conflict highlight may have changed, only the ones that are
+        //drawn in another color now have to be repainted
+        if (regionConflictUpdate(game, region))
+            regionMarkDirty(game, region);
+        for (int k = game->adjucencyStart[region]; k < game->adjucencyStart[region + 1]; ++k) {
+            if (regionConflictUpdate(game, game->adjucencyList[k]))
+                regionMarkDirty(game, game->adjucencyList[k]);
+        }
+    }
+
+    //a new color for region over a chain of at most Kempe_MaxChain regions, keep is not recolored
+    static bool regionMoveFind(struct Game *game, const int region, const int keep, KempeMove *move) {
+        return kempeRepairFind(&game->repair, game->adjucencyStart, game->adjucencyList, &game->regions[0].colorIndex,
+            sizeof(Region), game->regionCount, Color_Count, (1u << Color_Count) - 1, region, keep, move);
+    }
+
+    /*neighbours that got the color of the painted region move away from it, the painted region keeps its color.
+     *The ones without a short enough chain are left in conflict and counted in autoFixMissed */
+    static void regionAutoFix(struct Game *game, const int region) {
+        const int color = game->regions[region].colorIndex;
+        game->autoFixMissed = 0;
+        for (int k = game->adjucencyStart[region]; k < game->adjucencyStart[region + 1]; ++k) {
+            const int neighbour = game->adjucencyList[k];
+            KempeMove move;
+            if (game->regions[neighbour].colorIndex != color)
+                continue;
+            if (regionMoveFind(game, neighbour, region, &move))
+                repairApply(game, &move);
+            else
+                game->autoFixMissed++;
+        }
+    }
+
+    /*a move that clears a conflict. Conflicts around the last click come first, the painted region keeps its
+     *color there. Otherwise the lowest region in conflict is moved, or one of its neighbours that share its
+     *color. The chain of the move is only valid until the next call. False if there is no conflict or no move
+     *was found */
+    bool repairHint(struct Game *game, KempeMove *move) {
+        const int *start = game->adjucencyStart;
+        const int *list = game->adjucencyList;
+
+        const int last = game->lastPainted;
+        if (last >= 0 && regionInConflict(game, last)) {
+            for (int k = start[last]; k < start[last + 1]; ++k) {
+                const int n = list[k];
+                if (game->regions[n].colorIndex == game->regions[last].colorIndex && regionMoveFind(game, n, last, move))
+                    return true;
+            }
+        }
+
+        for (int word = 0; word < (game->regionCount + 31) / 32; ++word) {
+            if (!game->conflictBits[word])
+                continue;
+
+            int region = word * 32;
+            while (!regionInConflict(game, region))
+                ++region;
+
+            if (regionMoveFind(game, region, -1, move))
+                return true;
+            for (int k = start[region]; k < start[region + 1]; ++k) {
+                const int n = list[k];
+                if (game->regions[n].colorIndex == game->regions[region].colorIndex &&
+                    regionMoveFind(game, n, region, move))
+                    return true;
+            }
+            return false;
+        }
+        return false;
+    }
+
+    //play a move of repairHint: swap the colors of its chain, then recolor its region
+    void repairApply(struct Game *game, const KempeMove *move) {
+        for (int i = 0; i < move->chainLength; ++i) {
+            const int region = game->repair.chain[i];
+            regionPaint(game, region, game->regions[region].colorIndex == move->chainA ? move->chainB : move->chainA);
+        }
+        regionPaint(game, move->region, move->color);
+        game->repair.recolored += move->chainLength + 1;
+    }
+
+    static bool regionInConflict(const struct Game *game, const int region) {
+        return (game->conflictBits[region / 32] >> (region % 32)) & 1u;
+    }
+
+    /*recompute the conflict bit of one region from its neighbours, and with it the color the region is drawn in.
+     *True if that color changed */
+    static bool regionConflictUpdate(struct Game *game, const int region) {
+        const Uint32 mask = 1u << (region % 32);
+        if (conflictCheck(game, region))
+            game->conflictBits[region / 32] |= mask;
+        else
+            game->conflictBits[region / 32] &= ~mask;
+        return regionColorUpdate(game, region);
+    }
+
+    //color table entry of one region: gray while uncolored, its palette color, lighter while in conflict. True if it changed
+    static bool regionColorUpdate(struct Game *game, const int region) {
+        const int colorI = game->regions[region].colorIndex;
+        SDL_Color color = { 80, 80, 80, 255 };
+
+        if (colorI >= 0 && colorI < Color_Count) {
+            color = RGB_palette[colorI];
+
+            if (regionInConflict(game, region)) {
+                color.r = (color.r+255) / 2;
+                color.g = (color.g+255) / 2;
+                color.b = (color.b+255) / 2;
+            }
+        }
+        const Uint32 pixel = packColor(color);
+        const bool changed = game->regionColors[region + 1] != pixel;
+        game->regionColors[region + 1] = pixel;
+        return changed;
+    }
+
+    //queue the region for repainting on the next frame
+    static void regionMarkDirty(struct Game *game, const int region) {
+        if (game->regionDirty[region])
+            return;
+
+        game->regionDirty[region] = true;
+        game->dirtyRegions[game->dirtyCount++] = region;
+    }
+
+    /*place a dot somewhere on a plane randomly. Two dots on the same pixel would leave one region without any
+     *area that can never be painted, so a taken pixel is rolled again. The dots only depend on mapSeed, the
+     *region count and the map size, so a map ID gives the same map again */
+    void regionsGenerator(struct Game *game) {
+        Uint8 *taken = game->pixelTaken;
+        const Uint32 pixels = (Uint32)game->mapWidth * (Uint32)game->mapHeight;
+
+        Rng rng;
+        rngSeed(&rng, game->mapSeed);
+
+        for (int i = 0; i < game->regionCount; ++i) {
+            Uint32 pixel;
+            do {
+                pixel = rngBelow(&rng, pixels);
+            } while (taken[pixel]);
+
+            taken[pixel] = 1;
+            game->regions[i].point.x = (int)(pixel % (Uint32)game->mapWidth);
+            game->regions[i].point.y = (int)(pixel / (Uint32)game->mapWidth);
+
+            const SDL_Rect dot = { game->regions[i].point.x - 2, game->regions[i].point.y - 2, 4, 4 };
+            game->regionDots[i] = dot;
+
+            game->regions[i].colorIndex = -1;
+            regionColorUpdate(game, i);
+        }
+        regionBitsClear(&game->regionBits);
+
+        //label -1 of the borders picks the first entry
+        const SDL_Color border = { 0, 0, 0, 255 };
+        game->regionColors[0] = packColor(border);
+
+        //only the pixels that were marked are cleared, so the scratch is ready for the next map
+        for (int i = 0; i < game->regionCount; ++i)
+            taken[game->regions[i].point.y * game->mapWidth + game->regions[i].point.x] = 0;
+
+        game->adjucencyTriangulated = false;
+
+        //if the index can't be built find_closest_region falls back to the linear scan
+        if (!seedIndexBuild(&game->seedIndex, &game->regions[0].point, sizeof(Region), game->regionCount,
+            game->mapWidth, game->mapHeight)) {
+            fprintf(stderr, "Failed to allocate memory for the seed index\n");
+        }
+    }
+
+    //adjacency out of the delaunay triangulation of the region centers, false if it could not be built
+    static bool adjucencyTriangulate(struct Game *game) {
+        if (!delaunayBuild(&game->delaunay, &game->regions[0].point, sizeof(Region), game->regionCount,
+            game->mapWidth, game->mapHeight))
+            return false;
+
+        if (!adjucencyFromPairs(game, game->delaunay.pairs, game->delaunay.pairCount)) {
+            fprintf(stderr, "Failed to allocate memory for the adjacency list\n");
+            return false;
+        }
+        game->adjucencyTriangulated = true;
+        return true;
+    }
+
+    /*two regions are adjacent when their voronoi cells, clipped to the screen, share a border of non zero length.
+     *That is read from the delaunay triangulation of the region centers. The neighbour walk of labelMapBuild
+     *may have built it already for this map */
+    void adjucencyCheck(struct Game *game) {
+        if (game->adjucencyTriangulated || adjucencyTriangulate(game))
+            return;
+
+        fprintf(stderr, "Delaunay triangulation failed, sampling the label map for adjacency\n");
+
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+
+        int *pairs = NULL;
+        int pairCount = 0;
+        int pairCapacity = 0;
+
+        //iteration through the label map, every cell is compared with its right and bottom neighbour
+        for (int row = 0; row < gridRows; ++row) {
+            for (int col = 0; col < gridCols; ++col) {
+                const int c = game->labelMap[row * gridCols + col];
+
+                const int cRight = col + 1 < gridCols ? game->labelMap[row * gridCols + col + 1] : c;
+                const int cDown = row + 1 < gridRows ? game->labelMap[(row + 1) * gridCols + col] : c;
+
+                //if regions adre diff than they are adjusent, repeats are removed when the list is built
+                for (int side = 0; side < 2; ++side) {
+                    const int other = side == 0 ? cRight : cDown;
+                    if (other == c)
+                        continue;
+
+                    if (pairCount == pairCapacity) {
+                        const int grown = pairCapacity > 0 ? pairCapacity * 2 : 1024;
+                        int *memory = (int*)realloc(pairs, grown * 2 * sizeof(int));
+                        if (!memory) {
+                            free(pairs);
+                            fprintf(stderr, "Failed to allocate memory for the adjacency pairs\n");
+                            adjucencyFromPairs(game, NULL, 0);
+                            return;
+                        }
+                        pairs = memory;
+                        pairCapacity = grown;
+                    }
+
+                    pairs[pairCount * 2] = c;
+                    pairs[pairCount * 2 + 1] = other;
+                    ++pairCount;
+                }
+            }
+        }
+
+        if (!adjucencyFromPairs(game, pairs, pairCount))
+            fprintf(stderr, "Failed to allocate memory for the adjacency list\n");
+        free(pairs);
+    }
+
+    /*the voronoi cell of every region as a polygon, cut out of the map by the bisectors to its neighbours. That
+     *needs the adjacency of this map, with the lists sampled from the label map a neighbour with a very short
+     *border can be missing and the polygon then reaches a little into it. Without polygons the map is drawn
+     *from the cells */
+    void regionPolygonsBuild(struct Game *game) {
+        if (!voronoiPolygonsBuild(&game->polygons, &game->regions[0].point, sizeof(Region), game->regionCount,
+            game->mapWidth, game->mapHeight, game->adjucencyStart, game->adjucencyList, Polygon_BorderWidth,
+            unpackColor(game->regionColors[0])))
+            fprintf(stderr, "Failed to allocate memory for the region polygons, the map is drawn from cells\n");
+        game->repaintAll = true;
+    }
+
+    /*compressed neighbour lists out of region pairs. Every pair goes both ways, repeated pairs are dropped
+     *and the neighbours of a region end up sorted */
+    static bool adjucencyFromPairs(struct Game *game, const int *pairs, const int pairCount) {
+        const int n = game->regionCount;
+        int *start = game->adjucencyStart;
+
+        for (int i = 0; i <= n; ++i)
+            start[i] = 0;
+
+        if (pairCount * 2 > game->adjucencyCapacity) {
+            int *grown = (int*)realloc(game->adjucencyList, pairCount * 2 * sizeof(int));
+            if (!grown)
+                return false;
+            game->adjucencyList = grown;
+            game->adjucencyCapacity = pairCount * 2;
+        }
+
+        //degrees, then offsets, then placement with start[i] as the write cursor of region i - 1
+        for (int k = 0; k < pairCount; ++k) {
+            start[pairs[k * 2] + 1]++;
+            start[pairs[k * 2 + 1] + 1]++;
+        }
+        for (int i = 1; i <= n; ++i)
+            start[i] += start[i - 1];
+
+        for (int k = 0; k < pairCount; ++k) {
+            const int a = pairs[k * 2];
+            const int b = pairs[k * 2 + 1];
+            game->adjucencyList[start[a]++] = b;
+            game->adjucencyList[start[b]++] = a;
+        }
+        for (int i = n; i > 0; --i)
+            start[i] = start[i - 1];
+        start[0] = 0;
+
+        //sort every list (they are short, a planar map has less than 6 neighbours on average) and squeeze out repeats
+        int *list = game->adjucencyList;
+        int write = 0;
+        for (int i = 0; i < n; ++i) {
+            const int from = start[i];
+            const int to = start[i + 1];
+
+            for (int k = from + 1; k < to; ++k) {
+                const int value = list[k];
+                int j = k - 1;
+                while (j >= from && list[j] > value) {
+                    list[j + 1] = list[j];
+                    --j;
+                }
+                list[j + 1] = value;
+            }
+
+            start[i] = write;
+            for (int k = from; k < to; ++k) {
+                if (k == from || list[k] != list[k - 1])
+                    list[write++] = list[k];
+            }
+        }
+        start[n] = write;
+
+        //maps up to RegionBits_MaxRows regions also get the lists as bitset rows for conflictCheck, larger ones
+        //and a failed allocation leave it on the lists
+        regionBitsRows(&game->regionBits, start, list);
+        return true;
+    }
+
+    //owners of the cells in one band of Band_Rows rows, every band writes its own rows of the label map
+    static void labelMapBand(void *context, const int band) {
+        struct Game *game = (struct Game*)context;
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+        const int rowEnd = (band + 1) * Band_Rows < gridRows ? (band + 1) * Band_Rows : gridRows;
+
+        for (int row = band * Band_Rows; row < rowEnd; ++row) {
+            for (int col = 0; col < gridCols; ++col) {
+                //center of the current cell
+                const int centerX = col * Cell_Size + Cell_Size / 2;
+                const int centerY = row * Cell_Size + Cell_Size / 2;
+
+                game->labelMap[row * gridCols + col] = find_closest_region(game, centerX, centerY);
+            }
+        }
+        SDL_AtomicAdd(&game->labelQueries, (rowEnd - band * Band_Rows) * gridCols);
+    }
+
+    static const char *const LABEL_ENGINE_NAMES[] = {
+        "nearest",
+        "blocks",
+        "walk",
+        "transform"
+    };
+
+    static const char *const MAP_RENDER_NAMES[] = {
+        "cells",
+        "polygons"
+    };
+
+    //seed, region count and size of the current map, like 00c0ffee12345678-100-800x600
+    void mapIdFormat(const struct Game *game, char *id, const size_t size) {
+        snprintf(id, size, "%016llx-%d-%dx%d", (unsigned long long)game->mapSeed, game->regionCount, game->mapWidth,
+            game->mapHeight);
+    }
+
+    //the parts of a map ID, false if it is not one
+    bool mapIdParse(const char *id, Uint64 *seed, int *count, int *width, int *height) {
+        unsigned long long value;
+        int length = 0;
+        if (sscanf(id, "%llx-%d-%dx%d%n", &value, count, width, height, &length) != 4 || id[length] != '\0' ||
+            *count <= 0 || *width <= 0 || *height <= 0) {
+            fprintf(stderr, "Not a map ID: %s\n", id);
+            return false;
+        }
+        if (*width > Map_MaxSide || *height > Map_MaxSide) {
+            fprintf(stderr, "Map %s is too big, no side can be over %d\n", id, Map_MaxSide);
+            return false;
+        }
+
+        *seed = value;
+        return true;
+    }
+
+    //engine by its command line name, fallback if the name is unknown
+    LabelEngine labelEngineParse(const char *name, const LabelEngine fallback) {
+        for (int i = 0; i < (int)(sizeof(LABEL_ENGINE_NAMES) / sizeof(LABEL_ENGINE_NAMES[0])); ++i) {
+            if (strcmp(name, LABEL_ENGINE_NAMES[i]) == 0)
+                return (LabelEngine)i;
+        }
+        fprintf(stderr, "Unknown label engine %s\n", name);
+        return fallback;
+    }
+
+    const char *labelEngineName(const LabelEngine engine) {
+        return LABEL_ENGINE_NAMES[engine];
+    }
+
+    //renderer by its command line name, fallback if the name is unknown
+    MapRender mapRenderParse(const char *name, const MapRender fallback) {
+        for (int i = 0; i < (int)(sizeof(MAP_RENDER_NAMES) / sizeof(MAP_RENDER_NAMES[0])); ++i) {
+            if (strcmp(name, MAP_RENDER_NAMES[i]) == 0)
+                return (MapRender)i;
+        }
+        fprintf(stderr, "Unknown map renderer %s\n", name);
+        return fallback;
+    }
+
+    const char *mapRenderName(const MapRender render) {
+        return MAP_RENDER_NAMES[render];
+    }
+
+    /*owner of one cell, measured from its center. Cells of the tile being filled start at -1, a cell that was
+     *already looked up or filled is not searched again */
+    static int cellLabel(const struct Game *game, const int col, const int row, int *queries) {
+        int *label = &game->labelMap[row * (game->mapWidth / Cell_Size) + col];
+        if (*label < 0) {
+            *label = find_closest_region(game, col * Cell_Size + Cell_Size / 2, row * Cell_Size + Cell_Size / 2);
+            (*queries)++;
+        }
+        return *label;
+    }
+
+    /*fill the cells col0 .. col1, row0 .. row1 (inclusive). The cells a region owns are convex, also with ties
+     *going to the lower index, so four corners with the same owner mean the owner has every cell in between.
+     *Otherwise the block is split in the middle and the parts are filled the same way. Returns the amount
+     *of nearest seed searches */
+    static int blockFill(const struct Game *game, const int col0, const int row0, const int col1, const int row1) {
+        const int gridCols = game->mapWidth / Cell_Size;
+        int *labels = game->labelMap;
+        int queries = 0;
+
+        const int owner = cellLabel(game, col0, row0, &queries);
+        if (cellLabel(game, col1, row0, &queries) == owner && cellLabel(game, col0, row1, &queries) == owner &&
+            cellLabel(game, col1, row1, &queries) == owner) {
+            for (int row = row0; row <= row1; ++row) {
+                for (int col = col0; col <= col1; ++col)
+                    labels[row * gridCols + col] = owner;
+            }
+            return queries;
+        }
+
+        //a block that is at most 2 cells wide and high is only corners
+        const bool splitX = col1 - col0 >= 2;
+        const bool splitY = row1 - row0 >= 2;
+        const int midCol = (col0 + col1) / 2;
+        const int midRow = (row0 + row1) / 2;
+
+        if (splitX && splitY) {
+            queries += blockFill(game, col0, row0, midCol, midRow);
+            queries += blockFill(game, midCol, row0, col1, midRow);
+            queries += blockFill(game, col0, midRow, midCol, row1);
+            queries += blockFill(game, midCol, midRow, col1, row1);
+        } else if (splitX) {
+            queries += blockFill(game, col0, row0, midCol, row1);
+            queries += blockFill(game, midCol, row0, col1, row1);
+        } else if (splitY) {
+            queries += blockFill(game, col0, row0, col1, midRow);
+            queries += blockFill(game, col0, midRow, col1, row1);
+        } else {
+            //corners that were skipped because the first ones already differed
+            cellLabel(game, col1, row0, &queries);
+            cellLabel(game, col0, row1, &queries);
+            cellLabel(game, col1, row1, &queries);
+        }
+        return queries;
+    }
+
+    //one Block_Tile * Block_Tile tile of the label map, filled from its corners
+    static void labelMapTile(void *context, const int tile) {
+        struct Game *game = (struct Game*)context;
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+        const int tileCols = (gridCols + Block_Tile - 1) / Block_Tile;
+
+        const int col0 = tile % tileCols * Block_Tile;
+        const int row0 = tile / tileCols * Block_Tile;
+        const int col1 = (col0 + Block_Tile < gridCols ? col0 + Block_Tile : gridCols) - 1;
+        const int row1 = (row0 + Block_Tile < gridRows ? row0 + Block_Tile : gridRows) - 1;
+
+        for (int row = row0; row <= row1; ++row) {
+            for (int col = col0; col <= col1; ++col)
+                game->labelMap[row * gridCols + col] = -1;
+        }
+
+        SDL_AtomicAdd(&game->labelQueries, blockFill(game, col0, row0, col1, row1));
+    }
+
+    /*owner of the cell centered on x, y, starting from owner, the owner of a nearby cell. The walk moves to a
+     *neighbour while one is closer (or as close with a lower index). If a region is not the closest, the segment
+     *from it to x, y leaves its cell through a border with a closer neighbour, so the walk ends on the smallest
+     *distance. Regions tied for it lie on an empty circle around x, y and the ones next to each other on the
+     *circle are neighbours, so the lowest index is found by following ties only */
+    static int walkOwner(const struct Game *game, int owner, const int x, const int y) {
+        const Region *regions = game->regions;
+        const int *start = game->adjucencyStart;
+        const int *list = game->adjucencyList;
+
+        int best = sq2(x - regions[owner].point.x, y - regions[owner].point.y);
+        bool tied = false;
+        for (;;) {
+            int next = owner;
+            int nextDistance = best;
+            tied = false;
+            for (int k = start[owner]; k < start[owner + 1]; ++k) {
+                const int n = list[k];
+                const int d = sq2(x - regions[n].point.x, y - regions[n].point.y);
+                if (d < nextDistance || (d == nextDistance && n < next)) {
+                    next = n;
+                    nextDistance = d;
+                }
+                if (d == best)
+                    tied = true;
+            }
+            if (next == owner)
+                break;
+            owner = next;
+            best = nextDistance;
+        }
+
+        if (!tied)
+            return owner;
+
+        //every region at the same distance, reached over neighbours that are tied too
+        int ties[Walk_MaxTies];
+        int tieCount = 1;
+        ties[0] = owner;
+        for (int t = 0; t < tieCount; ++t) {
+            for (int k = start[ties[t]]; k < start[ties[t] + 1]; ++k) {
+                const int n = list[k];
+                if (sq2(x - regions[n].point.x, y - regions[n].point.y) != best)
+                    continue;
+
+                int seen = 0;
+                while (seen < tieCount && ties[seen] != n)
+                    ++seen;
+                if (seen < tieCount)
+                    continue;
+
+                if (tieCount == Walk_MaxTies)
+                    return find_closest_region(game, x, y);
+                ties[tieCount++] = n;
+                if (n < owner)
+                    owner = n;
+            }
+        }
+        return owner;
+    }
+
+    /*owners of one band of Band_Rows rows by walking the neighbour graph along every row. A row starts from the
+     *owner of the cell above it, only the first row of the band needs a nearest seed search */
+    static void labelMapWalkBand(void *context, const int band) {
+        struct Game *game = (struct Game*)context;
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+        const int rowEnd = (band + 1) * Band_Rows < gridRows ? (band + 1) * Band_Rows : gridRows;
+
+        int owner = find_closest_region(game, Cell_Size / 2, band * Band_Rows * Cell_Size + Cell_Size / 2);
+        for (int row = band * Band_Rows; row < rowEnd; ++row) {
+            int *labels = game->labelMap + row * gridCols;
+            const int centerY = row * Cell_Size + Cell_Size / 2;
+
+            if (row > band * Band_Rows)
+                owner = labels[-gridCols];
+            for (int col = 0; col < gridCols; ++col) {
+                owner = walkOwner(game, owner, col * Cell_Size + Cell_Size / 2, centerY);
+                labels[col] = owner;
+            }
+        }
+        SDL_AtomicAdd(&game->labelQueries, 1);
+    }
+
+    /*voronoi ownership of every cell. Regions only move in regionsGenerator, so this is done once per map
+     *and the renderer, adjacency check and mouse input just read the result. Every engine is spread over the
+     *worker threads, the bounding boxes and the borders of paintLabels are one pass over the finished map, the
+     *span table another one over paintLabels */
+    void labelMapBuild(struct Game *game) {
+        const int gridCols = game->mapWidth / Cell_Size;
+        const int gridRows = game->mapHeight / Cell_Size;
+
+        SDL_AtomicSet(&game->labelQueries, 0);
+
+        bool labeled = false;
+        if (game->labelEngine == LabelEngine_Transform) {
+            labeled = distanceTransformLabel(&game->transform, &game->regions[0].point, sizeof(Region),
+                game->regionCount, game->mapWidth, game->mapHeight, Cell_Size, game->labelMap, &game->workers);
+            if (!labeled)
+                fprintf(stderr, "Failed to allocate memory for the distance transform, using the nearest seed search\n");
+        }
+        if (game->labelEngine == LabelEngine_Walk) {
+            //the walk needs the delaunay neighbours of this map, adjucencyCheck then has nothing left to do
+            labeled = game->adjucencyTriangulated || adjucencyTriangulate(game);
+            if (labeled)
+                workerPoolRun(&game->workers, labelMapWalkBand, game, (gridRows + Band_Rows - 1) / Band_Rows);
+            else
+                fprintf(stderr, "Delaunay triangulation failed, using the nearest seed search for the label map\n");
+        }
+        if (!labeled && game->labelEngine == LabelEngine_Blocks) {
+            const int tiles = ((gridCols + Block_Tile - 1) / Block_Tile) * ((gridRows + Block_Tile - 1) / Block_Tile);
+            workerPoolRun(&game->workers, labelMapTile, game, tiles);
+            labeled = true;
+        }
+        if (!labeled)
+            workerPoolRun(&game->workers, labelMapBand, game, (gridRows + Band_Rows - 1) / Band_Rows);
+
+        for (int i = 0; i < game->regionCount; ++i) {
+            const SDL_Rect empty = { gridCols, gridRows, 0, 0 };
+            game->regionBounds[i] = empty;
+        }
+
+        for (int row = 0; row < gridRows; ++row) {
+            for (int col = 0; col < gridCols; ++col) {
+                const int *cell = &game->labelMap[row * gridCols + col];
+                const int closest = *cell;
+
+                //if the right or bottom neighbour belongs to another region than this is a border, drawn with label -1
+                const int closestRight = col + 1 < gridCols ? cell[1] : closest;
+                const int closestBelow = row + 1 < gridRows ? cell[gridCols] : closest;
+                game->paintLabels[row * gridCols + col] =
+                    closestRight != closest || closestBelow != closest ? -1 : closest;
+
+                //grow the bounding box of the owner, w and h hold the far corner until the end
+                SDL_Rect *bounds = &game->regionBounds[closest];
+                if (col < bounds->x) bounds->x = col;
+                if (row < bounds->y) bounds->y = row;
+                if (col + 1 > bounds->w) bounds->w = col + 1;
+                if (row + 1 > bounds->h) bounds->h = row + 1;
+            }
+        }
+
+        for (int i = 0; i < game->regionCount; ++i) {
+            SDL_Rect *bounds = &game->regionBounds[i];
+            if (bounds->w == 0) {
+                //region that owns no cell, nothing to paint
+                bounds->x = bounds->y = 0;
+                continue;
+            }
+            bounds->w -= bounds->x;
+            bounds->h -= bounds->y;
+        }
+
+        //the inside cells of every region as spans, what a recolor fills
+        if (!spanTableBuild(&game->spans, game->paintLabels, gridCols, gridRows, game->regionCount))
+            fprintf(stderr, "Failed to allocate memory for the span table, recolors repaint whole boxes\n");
+    }
+
+    /*four-color the current map with the solver. The colors of the player are replaced and the conflict
+     *counters start over, the map is repainted on the next frame. Anything but Coloring_Done leaves the map
+     *as it was */
+    ColoringResult autoSolve(struct Game *game, ColoringStats *stats) {
+        const ColoringResult result = coloringSolve(&game->solver, game->adjucencyStart, game->adjucencyList,
+            game->regionCount, Color_Count, (long long)Solve_NodesPerRegion * game->regionCount, stats);
+        if (result != Coloring_Done)
+            return result;
+
+        regionBitsClear(&game->regionBits);
+        for (int i = 0; i < (game->regionCount + 31) / 32; ++i)
+            game->conflictBits[i] = 0;
+        for (int i = 0; i < game->regionCount; ++i) {
+            game->regions[i].colorIndex = game->solver.colors[i];
+            regionBitsPaint(&game->regionBits, i, -1, game->solver.colors[i]);
+            regionColorUpdate(game, i);
+        }
+        game->uncoloredCount = 0;
+        game->conflictCount = 0;
+        game->repaintAll = true;
+        game->solverUsed = true;
+        return result;
+    }
+
+bool winCheck(const struct  Game *game) {
+        //everything painted and no neighbours share a color
+        return game->uncoloredCount == 0 && game->conflictCount == 0;
+    }
+
+
+    bool conflictCheck(const struct Game *game, int regionIndex) {
+        const int Color = game->regions[regionIndex].colorIndex;
+        if (Color< 0 )
+            return false;
+
+        //a few ANDs of the bitset row against the mask of the color on small maps, else the real neighbours
+        if (game->regionBits.hasRows)
+            return regionBitsClash(&game->regionBits, regionIndex, Color);
+        for (int k = game->adjucencyStart[regionIndex]; k < game->adjucencyStart[regionIndex + 1]; ++k) {
+            if (game->regions[game->adjucencyList[k]].colorIndex == Color)
+                return true;
+        }
+        return false;
+    }
+        //voronoi diagram implementation, the seed index only looks at the buckets around (x, y)
+        static int find_closest_region(const struct Game *game, const int x, const int y) {
+            if (game->seedIndex.count == game->regionCount && game->regionCount > 0)
+                return seedIndexNearest(&game->seedIndex, x, y);
+
+            return find_closest_region_linear(game, x, y);
+        }
+
+        //reference implementation, every region is looked at
+        static int find_closest_region_linear(const struct Game *game, const int x, const int y) {
+            int closest = 0;
+            int bestDistance = INT_MAX; //squared distances on the widest maps come close to it
+
+            //looking at all regions defined and calculating distance from (cx, cy) to region center(point.x, point,y)
+            for (int i = 0; i < game->regionCount; ++i) {
+                const int distanceX = x - game->regions[i].point.x;
+                const int distanceY = y - game->regions[i].point.y;
+
+                const int dist2 = sq2(distanceX, distanceY);
+
+                if (dist2 < bestDistance) {
+                    bestDistance = dist2;
+                    closest = i;//now this is the closest distance to points (cx,cy) with region index i
+                }
+            }
+            return closest;
+        }
+
+        //pack a color the same way as the SDL_PIXELFORMAT_ARGB8888 map texture
+        static Uint32 packColor(const SDL_Color color) {
+            return (Uint32)color.a << 24 | (Uint32)color.r << 16 | (Uint32)color.g << 8 | (Uint32)color.b;
+        }
+
+        /*write the colored voronoi map into the pixel buffer. Every cell is Cell_Size*Cell_Size pixels of the
+         *color table entry its paint label points at, so nothing but the table depends on the colors. Only the
+         *cells inside the rectangle (in cell units) are touched */
+        void mapPaint(const struct Game *game, const SDL_Rect *cells) {
+            const int width = game->mapWidth;
+            const int gridCols = game->mapWidth / Cell_Size;
+            const Uint32 *colors = game->regionColors + 1;
+            const size_t rowBytes = (size_t)cells->w * Cell_Size * sizeof(Uint32);
+
+            for (int row = cells->y; row < cells->y + cells->h; ++row) {
+                const int *labels = &game->paintLabels[row * gridCols];
+                Uint32 *dst = &game->mapPixels[row * Cell_Size * width];
+
+                for (int col = cells->x; col < cells->x + cells->w; ++col) {
+                    const Uint32 pixel = colors[labels[col]];
+                    for (int dx = 0; dx < Cell_Size; ++dx)
+                        dst[col * Cell_Size + dx] = pixel;
+                }
+
+                //the other pixel rows of the cell are copies of the first
+                for (int dy = 1; dy < Cell_Size; ++dy)
+                    memcpy(&dst[dy * width + cells->x * Cell_Size], &dst[cells->x * Cell_Size], rowBytes);
+            }
+        }
+
+        /*write the inside cells of one region into the pixel buffer, span by span. That is the area of the region,
+         *however far its bounding box reaches into other regions. Borders do not change with the color */
+        static void regionFill(const struct Game *game, const int region) {
+            const SpanTable *table = &game->spans;
+            const Uint32 pixel = game->regionColors[region + 1];
+
+            for (int k = table->regionStart[region]; k < table->regionStart[region + 1]; ++k) {
+                const MapSpan *span = &table->spans[k];
+                Uint32 *dst = &game->mapPixels[span->row * Cell_Size * game->mapWidth];
+                for (int dy = 0; dy < Cell_Size; ++dy, dst += game->mapWidth) {
+                    for (int x = span->start * Cell_Size; x < span->end * Cell_Size; ++x)
+                        dst[x] = pixel;
+                }
+            }
+        }
+
+        //one band of Band_Rows rows of the rectangle of a PaintJob
+        static void mapPaintBand(void *context, const int band) {
+            const PaintJob *job = (const PaintJob*)context;
+            const int rowEnd = job->cells.y + job->cells.h;
+            const int row = job->cells.y + band * Band_Rows;
+
+            const SDL_Rect cells = { job->cells.x, row, job->cells.w, row + Band_Rows < rowEnd ? Band_Rows : rowEnd - row };
+            mapPaint(job->game, &cells);
+        }
+
+        //unpack a color of the color table for the vertices of the polygons
+        static SDL_Color unpackColor(const Uint32 pixel) {
+            const SDL_Color color = { (Uint8)(pixel >> 16), (Uint8)(pixel >> 8), (Uint8)pixel, (Uint8)(pixel >> 24) };
+            return color;
+        }
+
+        //the map out of the paint labels, through the streaming texture
+        static void mapTextureDraw(struct Game *game) {
+            const int pitch = game->mapWidth * (int)sizeof(Uint32);
+            const int gridCols = game->mapWidth / Cell_Size;
+            const int gridRows = game->mapHeight / Cell_Size;
+
+            /*the texture keeps the map between frames, so only what changed is painted and uploaded: everything
+             *for a new map, otherwise the spans of the recolored regions and then the box around them in one
+             *upload. When their own boxes add up to more than that box, or there is no span table, the box is
+             *composited instead: the color table entries of the other regions in it are up to date, so their
+             *cells come out unchanged */
+            PaintJob job = { game, { 0, 0, gridCols, gridRows } };
+            bool composite = true;
+            if (!game->repaintAll) {
+                int right = 0;
+                int bottom = 0;
+                long long boxCells = 0;
+                job.cells.x = gridCols;
+                job.cells.y = gridRows;
+                for (int i = 0; i < game->dirtyCount; ++i) {
+                    const SDL_Rect *bounds = &game->regionBounds[game->dirtyRegions[i]];
+                    if (bounds->w == 0)
+                        continue;
+
+                    boxCells += (long long)bounds->w * bounds->h;
+                    if (bounds->x < job.cells.x) job.cells.x = bounds->x;
+                    if (bounds->y < job.cells.y) job.cells.y = bounds->y;
+                    if (bounds->x + bounds->w > right) right = bounds->x + bounds->w;
+                    if (bounds->y + bounds->h > bottom) bottom = bounds->y + bounds->h;
+                }
+                job.cells.w = right > job.cells.x ? right - job.cells.x : 0;
+                job.cells.h = bottom > job.cells.y ? bottom - job.cells.y : 0;
+
+                //regions spread over the map, like the chain of an auto-fix, are cheaper to composite in one box
+                composite = game->spans.regionCount != game->regionCount ||
+                    boxCells >= (long long)job.cells.w * job.cells.h;
+                for (int i = 0; i < game->dirtyCount && !composite; ++i)
+                    regionFill(game, game->dirtyRegions[i]);
+            }
+
+            if (job.cells.w > 0 && job.cells.h > 0) {
+                if (composite)
+                    workerPoolRun(&game->workers, mapPaintBand, &job, (job.cells.h + Band_Rows - 1) / Band_Rows);
+
+                const SDL_Rect pixels = { job.cells.x * Cell_Size, job.cells.y * Cell_Size,
+                    job.cells.w * Cell_Size, job.cells.h * Cell_Size };
+                SDL_UpdateTexture(game->mapTexture, &pixels, &game->mapPixels[pixels.y * game->mapWidth + pixels.x],
+                    pitch);
+            }
+
+            for (int i = 0; i < game->dirtyCount; ++i)
+                game->regionDirty[game->dirtyRegions[i]] = false;
+            game->dirtyCount = 0;
+            game->repaintAll = false;
+
+            //the map is drawn with a single copy
+            SDL_RenderCopy(game->renderer, game->mapTexture, NULL, NULL);
+        }
+
+        /*the map as the polygons of the regions: every polygon is a fan of triangles and every border between two
+         *regions a thin quad after them, all in one SDL_RenderGeometry call. Only the vertices of recolored regions
+         *change between frames. False if this map has no polygons, or if SDL_RenderGeometry failed which
+         *also switches back to cells */
+        static bool mapPolygonsDraw(struct Game *game) {
+            VoronoiPolygons *polygons = &game->polygons;
+            if (polygons->regionCount != game->regionCount)
+                return false;
+
+            if (game->repaintAll) {
+                for (int i = 0; i < game->regionCount; ++i)
+                    voronoiPolygonsColor(polygons, i, unpackColor(game->regionColors[i + 1]));
+            } else {
+                for (int i = 0; i < game->dirtyCount; ++i) {
+                    const int region = game->dirtyRegions[i];
+                    voronoiPolygonsColor(polygons, region, unpackColor(game->regionColors[region + 1]));
+                }
+            }
+
+            if (SDL_RenderGeometry(game->renderer, NULL, polygons->vertices, polygons->count, polygons->indices,
+                polygons->indexCount)) {
+                fprintf(stderr, "Could not draw the region polygons, drawing cells instead! SDL_Error: %s\n",
+                    SDL_GetError());
+                game->mapRender = MapRender_Cells;
+                game->repaintAll = true;
+                return false;
+            }
+
+            //the texture is not kept up to date meanwhile, switching back to cells has to repaint it whole
+            for (int i = 0; i < game->dirtyCount; ++i)
+                game->regionDirty[game->dirtyRegions[i]] = false;
+            game->dirtyCount = 0;
+            game->repaintAll = false;
+            return true;
+        }
+
+        //render the game itself using voronoi diagrams
+        void game_renderer(struct Game *game) {
+            //background
+            SDL_SetRenderDrawColor(game->renderer, 20, 20, 20, 255);
+            SDL_RenderClear(game->renderer);
+
+            if (game->mapRender != MapRender_Polygons || !mapPolygonsDraw(game))
+                mapTextureDraw(game);
+
+            //white dots for debugging purposes, all in one call
+            if (game->regionCount <= Dots_MaxRegions) {
+                SDL_SetRenderDrawColor(game->renderer, 255, 255, 255, 255);
+                SDL_RenderFillRects(game->renderer, game->regionDots, game->regionCount);
+            }
+
+            //small palettes for user to see chosen color
+            for (int i = 0; i < Color_Count; ++i) {
+                const int paletteSize = 40;
+                const int margin = 10;
+                SDL_Rect rect = {margin + i * (paletteSize + margin), game->mapHeight - paletteSize - margin,paletteSize, paletteSize};
+
+                const SDL_Color color = RGB_palette[i];
+                SDL_SetRenderDrawColor(game->renderer, color.r, color.g, color.b, color.a);
+                SDL_RenderFillRect(game->renderer, &rect);
+
+                //making the color selected rec visually intuitive
+                if (i == game->chosenColor) {
+                    SDL_SetRenderDrawColor(game->renderer, 255, 255, 255, 255);
+                    SDL_RenderDrawRect(game->renderer, &rect);
+
+                    SDL_Rect rr = { rect.x - 2, rect.y - 2, rect.w + 4, rect.h + 4 };
+                    SDL_RenderDrawRect(game->renderer, &rr);
+                } else {
+                    SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
+                    SDL_RenderDrawRect(game->renderer, &rect);
+                }
+            }
+
+            SDL_RenderPresent(game->renderer);
+        }
+
+        //menu function with difficulty selection.
+        void menu_renderer(const struct Game *game) {
+            SDL_SetRenderDrawColor(game->renderer, 10, 10, 40, 255);
+            SDL_RenderClear(game->renderer);
+
+
+            const int btnW = 300;
+            const int btnH = 60;
+            const int spacing = 20;
+            const int startY = 150;
+            const int centerX = game->mapWidth / 2 - btnW / 2;
+
+            const SDL_Rect easy   = { centerX, startY + 0 * (btnH + spacing), btnW, btnH };
+            const SDL_Rect medium = { centerX, startY + 1 * (btnH + spacing), btnW, btnH };
+            const SDL_Rect hard  = { centerX, startY + 2 * (btnH + spacing), btnW, btnH };
+
+            SDL_SetRenderDrawColor(game->renderer, 50, 150, 50, 255);
+            SDL_RenderFillRect(game->renderer, &easy);
+            SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
+            SDL_RenderDrawRect(game->renderer, &easy);
+
+            SDL_SetRenderDrawColor(game->renderer, 200, 200, 50, 255);
+            SDL_RenderFillRect(game->renderer, &medium);
+            SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
+            SDL_RenderDrawRect(game->renderer, &medium);
+
+            SDL_SetRenderDrawColor(game->renderer, 150, 50, 50, 255);
+            SDL_RenderFillRect(game->renderer, &hard);
+            SDL_SetRenderDrawColor(game->renderer, 0, 0, 0, 255);
+            SDL_RenderDrawRect(game->renderer, &hard);
+
+            SDL_RenderPresent(game->renderer);
+        }
+
+
+
+        bool sdl_initialise(struct Game *game) {
+            if (SDL_Init(SDL_INIT_EVERYTHING)) {
+                fprintf(stderr, "SDL could not initialize! SDL_Error:  %s\n", SDL_GetError());
+                return true;
+            }
+
+            if (game->mapWidth < Cell_Size || game->mapHeight < Cell_Size) {
+                fprintf(stderr, "Map size %dx%d is too small\n", game->mapWidth, game->mapHeight);
+                return true;
+            }
+            if (game->mapWidth > Map_MaxSide || game->mapHeight > Map_MaxSide) {
+                fprintf(stderr, "Map size %dx%d is too big, no side can be over %d\n", game->mapWidth, game->mapHeight,
+                    Map_MaxSide);
+                return true;
+            }
+            const size_t pixels = (size_t)game->mapWidth * (size_t)game->mapHeight;
+            const size_t cells = (size_t)(game->mapWidth / Cell_Size) * (size_t)(game->mapHeight / Cell_Size);
+
+            //Window creation
+            game -> window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                game->mapWidth, game->mapHeight, SDL_WINDOW_SHOWN );
+            if (game->window == NULL) {
+                fprintf(stderr, "Window could not be crated! SDL_Error: %s\n", SDL_GetError());
+                return true;
+            }
+
+            //Renderer setup
+            game -> renderer = SDL_CreateRenderer(game->window, -1, 0);
+            if (game->renderer == NULL) {
+                fprintf(stderr, "Error creating window! SDL_Error: %s\n", SDL_GetError());
+                return true;
+            }
+
+            //Map texture, rewritten from mapPixels every frame
+            game -> mapTexture = SDL_CreateTexture(game->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                game->mapWidth, game->mapHeight);
+            if (game->mapTexture == NULL) {
+                fprintf(stderr, "Error creating map texture! SDL_Error: %s\n", SDL_GetError());
+                return true;
+            }
+
+            game->mapPixels = (Uint32*)calloc(pixels, sizeof(Uint32));
+            if (!game->mapPixels) {
+                fprintf(stderr, "Failed to allocate memory for the map pixels\n");
+                return true;
+            }
+
+            //per region arrays are sized by setDifficulty once the region count is known
+            game->pixelTaken = (Uint8*)calloc(pixels, sizeof(Uint8));
+            if (!game->pixelTaken) {
+                fprintf(stderr, "Failed to allocate memory for the region generator\n");
+                return true;
+            }
+
+            game->labelMap = (int*)malloc(cells * sizeof(int));
+            if (!game->labelMap) {
+                fprintf(stderr, "Failed to allocate memory for the label map\n");
+                return true;
+            }
+
+            game->paintLabels = (int*)malloc(cells * sizeof(int));
+            if (!game->paintLabels) {
+                fprintf(stderr, "Failed to allocate memory for the paint labels\n");
+                return true;
+            }
+
+            //label map and full repaints are split over these, one thread less than the cpu count
+            workerPoolStart(&game->workers, -1);
+
+            return false;
+        }
\ No newline at end of file
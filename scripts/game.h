@@ -0,0 +1,158 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "coloring_solver.h"
+#include "delaunay.h"
+#include "distance_transform.h"
+#include "kempe_repair.h"
+#include "region_bits.h"
+#include "rng.h"
+#include "seed_index.h"
+#include "span_table.h"
+#include "voronoi_polygons.h"
+#include "worker_pool.h"
+
+#define Color_Count 4
+#define Cell_Size 2
+#define WINDOW_TITLE "Four Color Theorem"
+
+//longest side of a map in pixels, the seed index and its kernels take coordinates up to SeedKernel_MaxCoordinate
+#define Map_MaxSide (SeedKernel_MaxCoordinate + 1)
+
+//room for a map ID with its terminating zero
+#define MapId_Size 48
+
+typedef enum {
+    Easy,
+    Medium,
+    Hard,
+    Custom, // region count from the command line, for stress testing
+}Difficulty;
+
+//how labelMapBuild finds the owner of every cell
+typedef enum {
+    LabelEngine_Nearest, // nearest seed search for every cell
+    LabelEngine_Blocks, // nearest seed search for block corners, blocks with one owner are filled whole
+    LabelEngine_Walk, // along every row only the neighbours of the last owner are tested
+    LabelEngine_Transform, // distance transform, cost does not depend on the region count
+}LabelEngine;
+
+//how game_renderer draws the map
+typedef enum {
+    MapRender_Cells, // the paint labels composited into a texture, Cell_Size squares with borders of cells
+    MapRender_Polygons, // the voronoi polygons of the regions as triangles, borders as lines
+}MapRender;
+
+typedef enum {
+    Menu,
+    Game
+}GameState;
+
+typedef struct {
+    SDL_Point point; // center of the regions as a dot
+    int colorIndex;
+}Region;
+
+struct Game {
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    SDL_Texture *mapTexture; // streaming texture the whole colored map is uploaded to
+
+    //size of the map (and the window) in pixels, has to be set before sdl_initialise
+    int mapWidth;
+    int mapHeight;
+
+    Uint32 *mapPixels; // ARGB8888 copy of the map, mapWidth * mapHeight
+
+    Region *regions;
+    SDL_Rect *regionDots; // a dot on the center of every region, placed by regionsGenerator
+    Rng rng; // picks the seed of every new map, seeded once per session
+    Uint64 mapSeed; // the region centers of the current map come from this seed alone
+    bool mapSeedGiven; // mapSeed was set from a map ID, the next map uses it instead of a new one
+    SeedIndex seedIndex; // grid buckets over the region centers, rebuilt by regionsGenerator
+
+    int chosenColor;
+    int regionCount;
+    int regionCapacity; // regions the per region arrays have room for, they only grow
+    int customRegionCount;
+
+    Difficulty difficulty;
+    GameState gameState;
+
+    //neighbours of region i are adjucencyList[adjucencyStart[i] .. adjucencyStart[i + 1]), rebuilt by adjucencyCheck
+    int *adjucencyStart;
+    int *adjucencyList;
+    int adjucencyCapacity;
+    Delaunay delaunay; // triangulation of the region centers, gives the exact adjacency
+    bool adjucencyTriangulated; // the lists come from the triangulation of the current region centers
+
+    WorkerPool workers; // threads the label map and whole map repaints are split over
+
+    Uint8 *pixelTaken; // scratch for regionsGenerator, pixels that already hold a region center
+
+    int *labelMap; // owning region of every Cell_Size cell, rebuilt only when the map changes
+    LabelEngine labelEngine; // all of them give the same label map
+    DistanceTransform transform;
+    SDL_atomic_t labelQueries; // nearest seed searches made by the last labelMapBuild
+    SDL_Rect *regionBounds; // bounding box of every region in cells, built together with the label map
+    int *paintLabels; // the label map with -1 on border cells, what mapPaint looks up in regionColors
+    SpanTable spans; // inside cells of every region as runs of paintLabels, for repainting one region
+    Uint32 *regionColors; // ARGB8888 color of region i at i + 1 and of the borders at 0, kept by every recolor
+    MapRender mapRender; // set repaintAll when changing it, the texture is left as it is while polygons are drawn
+    VoronoiPolygons polygons; // built with the adjacency of every map, drawn in MapRender_Polygons
+
+    bool *regionDirty; // regions whose pixels have to be repainted on the next frame
+    int *dirtyRegions;
+    int dirtyCount;
+    bool repaintAll; // new map or lost texture, the whole map is repainted
+
+    //kept up to date by mouse_input, so winCheck does not have to look at the map
+    int uncoloredCount;
+    int conflictCount; // neighbouring pairs painted the same color
+    Uint32 *conflictBits; // one bit per region, set while it shares its color with a neighbour
+    RegionBits regionBits; // a mask of regions per color, with adjacency rows for conflictCheck on small maps
+
+    ColoringSolver solver;
+    bool solverUsed; // the map was colored by autoSolve, that is no win
+
+    KempeRepair repair;
+    bool autoFix; // conflicts a click makes are repaired right away by recoloring the neighbours
+    int lastPainted; // region of the last click, -1 on a new map
+    int autoFixMissed; // conflicts of the last click auto-fix found no chain of at most Kempe_MaxChain regions for
+
+    Uint32 startTimer;
+    Uint32 finishTimer;
+
+    bool winState;
+};
+
+extern const SDL_Color RGB_palette[Color_Count];
+
+bool sdl_initialise(struct Game *game);
+bool conflictCheck(const struct  Game *game, int regionIndex);
+bool winCheck(const struct  Game *game);
+void game_cleanup(struct Game *game);
+void game_renderer(struct Game *game);
+void mapPaint(const struct Game *game, const SDL_Rect *cells);
+bool mouse_input(struct Game *game, int x, int y);
+int regionAt(const struct Game *game, int x, int y);
+void regionsGenerator(struct Game *game);
+void menu_renderer(const struct Game* game);
+void adjucencyCheck(struct Game *game);
+void labelMapBuild(struct Game *game);
+void regionPolygonsBuild(struct Game *game);
+bool setDifficulty(struct Game *game, Difficulty diff);
+ColoringResult autoSolve(struct Game *game, ColoringStats *stats);
+bool repairHint(struct Game *game, KempeMove *move);
+void repairApply(struct Game *game, const KempeMove *move);
+LabelEngine labelEngineParse(const char *name, LabelEngine fallback);
+void mapIdFormat(const struct Game *game, char *id, size_t size);
+bool mapIdParse(const char *id, Uint64 *seed, int *count, int *width, int *height);
+const char *labelEngineName(LabelEngine engine);
+MapRender mapRenderParse(const char *name, MapRender fallback);
+const char *mapRenderName(MapRender render);
+
+#endif
@@ -0,0 +1,131 @@
+#include "kempe_repair.h"
+
+#include <stdlib.h>
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+static int colorAt(const int *colors, const size_t stride, const int i) {
+    return *(const int*)((const Uint8*)colors + (size_t)i * stride);
+}
+
+bool kempeRepairFind(KempeRepair *repair, const int *start, const int *list, const int *colors, const size_t stride,
+    const int count, const int colorCount, const Uint32 allowed, const int region, const int keep, KempeMove *move) {
+    if (region < 0 || region >= count || colorCount < 2 || colorCount > 32)
+        return false;
+
+    if (count > repair->capacity) {
+        if (!resizeArray((void**)&repair->visit, count, sizeof(int)) ||
+            !resizeArray((void**)&repair->chain, count < Kempe_MaxChain ? count : Kempe_MaxChain, sizeof(int)) ||
+            !resizeArray((void**)&repair->scratch, count < Kempe_MaxChain ? count : Kempe_MaxChain, sizeof(int)))
+            return false;
+        for (int i = repair->capacity; i < count; ++i)
+            repair->visit[i] = 0;
+        repair->capacity = count;
+    }
+
+    move->region = region;
+    move->chainLength = 0;
+    move->chainA = -1;
+    move->chainB = -1;
+
+    //a color none of the neighbours has needs no chain
+    Uint32 blocked = 0;
+    for (int k = start[region]; k < start[region + 1]; ++k) {
+        const int c = colorAt(colors, stride, list[k]);
+        if (c >= 0)
+            blocked |= 1u << c;
+    }
+    for (int c = 0; c < colorCount; ++c) {
+        if ((allowed & ~blocked) >> c & 1) {
+            move->color = c;
+            return true;
+        }
+    }
+
+    //every pair of colors is tried and the shortest chain wins, a search stops once it is as long as the best one
+    int limit = count < Kempe_MaxChain ? count : Kempe_MaxChain;
+    bool found = false;
+    for (int a = 0; a < colorCount; ++a) {
+        if (!(allowed >> a & 1))
+            continue;
+
+        for (int b = 0; b < colorCount; ++b) {
+            if (a == b)
+                continue;
+
+            int *chain = repair->scratch;
+            const int stamp = ++repair->stamp;
+            int queued = 0;
+            bool stuck = false;
+
+            //the region itself is left out of the chain, the b neighbours and keep must not be reached
+            repair->visit[region] = stamp;
+            for (int k = start[region]; k < start[region + 1]; ++k) {
+                const int n = list[k];
+                if (colorAt(colors, stride, n) == b)
+                    repair->visit[n] = -stamp;
+            }
+            if (keep >= 0 && keep != region)
+                repair->visit[keep] = -stamp;
+
+            for (int k = start[region]; k < start[region + 1] && !stuck; ++k) {
+                const int n = list[k];
+                if (colorAt(colors, stride, n) != a || repair->visit[n] == stamp)
+                    continue;
+                if (repair->visit[n] == -stamp || queued == limit) {
+                    stuck = true;
+                    break;
+                }
+                repair->visit[n] = stamp;
+                chain[queued++] = n;
+            }
+
+            for (int q = 0; q < queued && !stuck; ++q) {
+                const int w = chain[q];
+                for (int k = start[w]; k < start[w + 1]; ++k) {
+                    const int n = list[k];
+                    const int c = colorAt(colors, stride, n);
+                    if ((c != a && c != b) || repair->visit[n] == stamp)
+                        continue;
+                    if (repair->visit[n] == -stamp || queued == limit) {
+                        stuck = true;
+                        break;
+                    }
+                    repair->visit[n] = stamp;
+                    chain[queued++] = n;
+                }
+            }
+            if (stuck)
+                continue;
+
+            repair->scratch = repair->chain;
+            repair->chain = chain;
+            move->color = a;
+            move->chainA = a;
+            move->chainB = b;
+            move->chainLength = queued;
+            limit = queued;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void kempeRepairFree(KempeRepair *repair) {
+    free(repair->visit);
+    free(repair->chain);
+    free(repair->scratch);
+
+    repair->visit = NULL;
+    repair->chain = NULL;
+    repair->scratch = NULL;
+    repair->capacity = 0;
+    repair->stamp = 0;
+}
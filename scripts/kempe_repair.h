@@ -0,0 +1,45 @@
+#ifndef KEMPE_REPAIR_H
+#define KEMPE_REPAIR_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+/*regions a chain may have before it is given up. A longer swap is no local fix any more, for a click or for a dead
+ *end of the solver, which jumps back instead */
+#define Kempe_MaxChain 64
+
+/*a fix for one region: first the colors chainA and chainB are swapped on the chain, then region gets color.
+ *chainLength is 0 when the color was free already */
+typedef struct {
+    int region;
+    int color;
+    int chainA;
+    int chainB;
+    int chainLength;
+} KempeMove;
+
+/*local repair of a partly colored map. A region that has to give up its color takes one no neighbour has. If
+ *every color is taken, two colors a and b are swapped on a Kempe chain: the regions colored a or b that are
+ *connected over such regions to the a neighbours of the region. If that chain does not reach a b neighbour,
+ *after the swap no neighbour has a any more. Of all pairs the shortest chain is taken. A swap never creates a
+ *new conflict, so the cost is the chains and the neighbours of the region, not the map. Buffers are kept between calls and only grow */
+typedef struct {
+    int *visit; // per region stamp of the chain search, negative for regions the chain must not reach
+    int *chain; // regions of the chain of the last move found
+    int *scratch; // chain being searched, swapped with chain when it is shorter
+    int capacity;
+    int stamp;
+
+    long long recolored; // regions recolored through moves so far, for statistics
+} KempeRepair;
+
+/*find a new color for region out of the colors in allowed, the regions colored by a chain are left in
+ *repair->chain. The neighbours of i are list[start[i] .. start[i + 1]), colors are ints stride bytes apart, -1 for
+ *uncolored. The current color of region is ignored and keep (-1 for none) is not recolored by the chain. Returns
+ *false if there is no move with a chain of at most Kempe_MaxChain regions or memory ran out */
+bool kempeRepairFind(KempeRepair *repair, const int *start, const int *list, const int *colors, size_t stride,
+    int count, int colorCount, Uint32 allowed, int region, int keep, KempeMove *move);
+
+void kempeRepairFree(KempeRepair *repair);
+
+#endif
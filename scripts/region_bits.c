@@ -0,0 +1,143 @@
+#include "region_bits.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+static int popCount(Uint64 word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int)((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static int lowestBit(const Uint64 word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word >> bit & 1))
+        ++bit;
+    return bit;
+#endif
+}
+
+static Uint64 *maskOf(const RegionBits *bits, const int color) {
+    return bits->masks + (size_t)(color < 0 ? bits->colorCount : color) * bits->words;
+}
+
+bool regionBitsReset(RegionBits *bits, const int count, const int colorCount) {
+    const int words = (count + 63) / 64;
+    const size_t maskWords = (size_t)(colorCount + 1) * words;
+
+    bits->hasRows = false;
+    if (maskWords > bits->maskCapacity) {
+        if (!resizeArray((void**)&bits->masks, maskWords, sizeof(Uint64)))
+            return false;
+        bits->maskCapacity = maskWords;
+    }
+
+    bits->count = count;
+    bits->colorCount = colorCount;
+    bits->words = words;
+    regionBitsClear(bits);
+    return true;
+}
+
+void regionBitsClear(RegionBits *bits) {
+    memset(bits->masks, 0, (size_t)(bits->colorCount + 1) * bits->words * sizeof(Uint64));
+
+    //the bits past the last region stay clear, so counts and sweeps need no special last word
+    Uint64 *uncolored = maskOf(bits, -1);
+    for (int w = 0; w < bits->count / 64; ++w)
+        uncolored[w] = ~0ull;
+    if (bits->count % 64)
+        uncolored[bits->count / 64] = (1ull << (bits->count % 64)) - 1;
+}
+
+bool regionBitsRows(RegionBits *bits, const int *start, const int *list) {
+    bits->hasRows = false;
+    if (bits->count > RegionBits_MaxRows)
+        return false;
+
+    const size_t rowWords = (size_t)bits->count * bits->words;
+    if (rowWords > bits->rowCapacity) {
+        if (!resizeArray((void**)&bits->rows, rowWords, sizeof(Uint64)))
+            return false;
+        bits->rowCapacity = rowWords;
+    }
+
+    memset(bits->rows, 0, rowWords * sizeof(Uint64));
+    for (int i = 0; i < bits->count; ++i) {
+        Uint64 *row = bits->rows + (size_t)i * bits->words;
+        for (int k = start[i]; k < start[i + 1]; ++k)
+            row[list[k] / 64] |= 1ull << (list[k] % 64);
+    }
+    bits->hasRows = true;
+    return true;
+}
+
+void regionBitsPaint(RegionBits *bits, const int region, const int oldColor, const int newColor) {
+    const Uint64 bit = 1ull << (region % 64);
+    maskOf(bits, oldColor)[region / 64] &= ~bit;
+    maskOf(bits, newColor)[region / 64] |= bit;
+}
+
+bool regionBitsClash(const RegionBits *bits, const int region, const int color) {
+    const Uint64 *row = bits->rows + (size_t)region * bits->words;
+    const Uint64 *mask = maskOf(bits, color);
+
+    Uint64 any = 0;
+    for (int w = 0; w < bits->words; ++w)
+        any |= row[w] & mask[w];
+    return any != 0;
+}
+
+int regionBitsCount(const RegionBits *bits, const int color) {
+    const Uint64 *mask = maskOf(bits, color);
+
+    int total = 0;
+    for (int w = 0; w < bits->words; ++w)
+        total += popCount(mask[w]);
+    return total;
+}
+
+bool regionBitsSolved(const RegionBits *bits) {
+    if (regionBitsCount(bits, -1) > 0)
+        return false;
+
+    //every region against the mask of its own color, found by walking the set bits of each mask
+    for (int c = 0; c < bits->colorCount; ++c) {
+        const Uint64 *mask = maskOf(bits, c);
+        for (int w = 0; w < bits->words; ++w) {
+            for (Uint64 word = mask[w]; word; word &= word - 1) {
+                if (regionBitsClash(bits, w * 64 + lowestBit(word), c))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+void regionBitsFree(RegionBits *bits) {
+    free(bits->rows);
+    free(bits->masks);
+
+    bits->rows = NULL;
+    bits->masks = NULL;
+    bits->rowCapacity = 0;
+    bits->maskCapacity = 0;
+    bits->hasRows = false;
+}
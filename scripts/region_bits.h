@@ -0,0 +1,50 @@
+#ifndef REGION_BITS_H
+#define REGION_BITS_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+//largest map that gets adjacency rows, they take count * count / 8 bytes (2 MiB here)
+#define RegionBits_MaxRows 4096
+
+/*regions as bitsets of 64 bit words. Mask c has bit i set while region i is painted c, the last mask holds the
+ *regions without a color. Small maps also get the neighbours of every region as a row, then a region clashes
+ *with color c when its row and mask c share a bit: count / 64 ANDs, whatever the degree. Buffers only grow */
+typedef struct {
+    Uint64 *rows; // count rows of words each, valid while hasRows is set
+    Uint64 *masks; // colorCount + 1 masks of words each
+    int count;
+    int colorCount;
+    int words; // 64 bit words per row and per mask
+    bool hasRows;
+
+    size_t rowCapacity; // in words
+    size_t maskCapacity;
+} RegionBits;
+
+//count regions, all uncolored and without rows. Returns false if memory ran out
+bool regionBitsReset(RegionBits *bits, int count, int colorCount);
+
+//every region back to uncolored, the rows are kept
+void regionBitsClear(RegionBits *bits);
+
+/*rows out of the neighbour lists list[start[i] .. start[i + 1]) of the regions given to regionBitsReset. Maps above
+ *RegionBits_MaxRows get none, false then and when memory ran out */
+bool regionBitsRows(RegionBits *bits, const int *start, const int *list);
+
+//move region from oldColor to newColor in the masks, -1 for uncolored
+void regionBitsPaint(RegionBits *bits, int region, int oldColor, int newColor);
+
+//a neighbour of region is painted color, needs rows
+bool regionBitsClash(const RegionBits *bits, int region, int color);
+
+//regions painted color, -1 for the uncolored ones
+int regionBitsCount(const RegionBits *bits, int color);
+
+/*every region is painted and no neighbours share a color, needs rows. The game keeps running counters for
+ *winCheck instead, this is the sweep Adjacency_Benchmark compares */
+bool regionBitsSolved(const RegionBits *bits);
+
+void regionBitsFree(RegionBits *bits);
+
+#endif
@@ -0,0 +1,41 @@
+#include "rng.h"
+
+static Uint64 rotateLeft(const Uint64 x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void rngSeed(Rng *rng, Uint64 seed) {
+    for (int i = 0; i < 4; ++i) {
+        seed += 0x9E3779B97F4A7C15ull;
+        Uint64 z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        rng->state[i] = z ^ (z >> 31);
+    }
+}
+
+Uint64 rngNext(Rng *rng) {
+    Uint64 *s = rng->state;
+    const Uint64 result = rotateLeft(s[1] * 5, 7) * 9;
+    const Uint64 t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+    return result;
+}
+
+/*the high half of a 32x32 bit product is the draw. Only products whose low half falls below 2^32 mod bound
+ *would make some values more likely, those are drawn again, which almost never happens */
+Uint32 rngBelow(Rng *rng, const Uint32 bound) {
+    Uint64 product = (rngNext(rng) >> 32) * bound;
+    if ((Uint32)product < bound) {
+        const Uint32 threshold = (0u - bound) % bound;
+        while ((Uint32)product < threshold)
+            product = (rngNext(rng) >> 32) * bound;
+    }
+    return (Uint32)(product >> 32);
+}
@@ -0,0 +1,20 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <SDL.h>
+
+/*xoshiro256** with all of its state in the struct, so every user owns its own sequence and the same seed gives
+ *the same numbers on every platform. Four 64 bit words, a handful of shifts and rotations per number */
+typedef struct {
+    Uint64 state[4];
+} Rng;
+
+//fill the state from one 64 bit seed with splitmix64, any seed including 0 gives a usable state
+void rngSeed(Rng *rng, Uint64 seed);
+
+Uint64 rngNext(Rng *rng);
+
+//uniform in 0 .. bound - 1 without modulo bias (Lemire's multiply and reject), bound must not be 0
+Uint32 rngBelow(Rng *rng, Uint32 bound);
+
+#endif
@@ -0,0 +1,194 @@
+#include "seed_index.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+
+//average amount of seeds we want to see in one bucket
+#define Seeds_PerBucket 2
+
+static bool growInts(int **array, const int capacity) {
+    int *grown = (int*)realloc(*array, capacity * sizeof(int));
+    if (!grown)
+        return false;
+
+    *array = grown;
+    return true;
+}
+
+bool seedIndexBuild(SeedIndex *index, const SDL_Point *points, const size_t stride, const int count,
+    const int width, const int height) {
+    index->count = 0;
+    index->cols = 0;
+    index->rows = 0;
+
+    if (count <= 0 || width <= 0 || height <= 0)
+        return true;
+
+    //the kernels work on 16 bit differences and int distances
+    if (width > SeedKernel_MaxCoordinate + 1 || height > SeedKernel_MaxCoordinate + 1)
+        return false;
+
+    //bucket side picked so that a bucket holds Seeds_PerBucket seeds on average
+    int bucketSize = (int)ceil(sqrt((double)width * height * Seeds_PerBucket / count));
+    if (bucketSize < 1)
+        bucketSize = 1;
+
+    const int cols = (width + bucketSize - 1) / bucketSize;
+    const int rows = (height + bucketSize - 1) / bucketSize;
+
+    if (count > index->capacity) {
+        if (!growInts(&index->seedX, count) || !growInts(&index->seedY, count) || !growInts(&index->seedId, count))
+            return false;
+        index->capacity = count;
+    }
+
+    if (cols * rows + 1 > index->bucketCapacity) {
+        if (!growInts(&index->bucketStart, cols * rows + 1))
+            return false;
+        index->bucketCapacity = cols * rows + 1;
+    }
+
+    index->bucketSize = bucketSize;
+    index->cols = cols;
+    index->rows = rows;
+
+    for (int b = 0; b <= cols * rows; ++b)
+        index->bucketStart[b] = 0;
+
+    const Uint8 *base = (const Uint8*)points;
+
+    //counting sort by bucket: sizes first, then prefix sums, then placement in the original order
+    for (int i = 0; i < count; ++i) {
+        const SDL_Point *p = (const SDL_Point*)(base + i * stride);
+        const int b = (p->y / bucketSize) * cols + p->x / bucketSize;
+        index->bucketStart[b + 1]++;
+    }
+
+    for (int b = 0; b < cols * rows; ++b)
+        index->bucketStart[b + 1] += index->bucketStart[b];
+
+    for (int i = 0; i < count; ++i) {
+        const SDL_Point *p = (const SDL_Point*)(base + i * stride);
+        const int b = (p->y / bucketSize) * cols + p->x / bucketSize;
+
+        //bucketStart[b] is used as the write cursor and shifted back afterwards
+        const int slot = index->bucketStart[b]++;
+        index->seedX[slot] = p->x;
+        index->seedY[slot] = p->y;
+        index->seedId[slot] = i;
+    }
+
+    for (int b = cols * rows; b > 0; --b)
+        index->bucketStart[b] = index->bucketStart[b - 1];
+    index->bucketStart[0] = 0;
+
+    index->count = count;
+    seedIndexSetKernel(index, seedKernelBest());
+    return true;
+}
+
+void seedIndexSetKernel(SeedIndex *index, const SeedKernel kernel) {
+    index->kernel = kernel;
+    index->scan = seedKernelScan(kernel);
+}
+
+static int clampInt(const int value, const int low, const int high) {
+    return value < low ? low : value > high ? high : value;
+}
+
+int seedIndexNearest(const SeedIndex *index, const int x, const int y) {
+    if (index->count == 0)
+        return -1;
+
+    const int size = index->bucketSize;
+    const int bx = clampInt(x / size, 0, index->cols - 1);
+    const int by = clampInt(y / size, 0, index->rows - 1);
+
+    int best = INT_MAX;
+    int bestDistance = INT_MAX;
+
+    const int *start = index->bucketStart;
+    const int cols = index->cols;
+
+    /*look at square rings of buckets around the query bucket. After ring r every seed that is not checked yet
+     *lies outside the block of buckets (bx - r .. bx + r, by - r .. by + r), so once the distance to the border
+     *of that block is larger than the best distance nothing closer can be left.
+     *Buckets are stored row by row, so the top and bottom row of a ring is one run of seeds for the kernel */
+    for (int r = 0; ; ++r) {
+        const int left = bx - r;
+        const int right = bx + r;
+        const int top = by - r;
+        const int bottom = by + r;
+
+        const int first = left > 0 ? left : 0;
+        const int last = right < cols - 1 ? right : cols - 1;
+
+        for (int cy = top; cy <= bottom; ++cy) {
+            if (cy < 0 || cy >= index->rows)
+                continue;
+
+            const int row = cy * cols;
+            if (cy == top || cy == bottom) {
+                index->scan(index->seedX, index->seedY, index->seedId, start[row + first], start[row + last + 1],
+                    x, y, &best, &bestDistance);
+                continue;
+            }
+
+            //inner rows of the ring only have their two end buckets
+            if (left >= 0)
+                index->scan(index->seedX, index->seedY, index->seedId, start[row + left], start[row + left + 1],
+                    x, y, &best, &bestDistance);
+            if (right < cols)
+                index->scan(index->seedX, index->seedY, index->seedId, start[row + right], start[row + right + 1],
+                    x, y, &best, &bestDistance);
+        }
+
+        //whole grid covered
+        if (left <= 0 && top <= 0 && right >= index->cols - 1 && bottom >= index->rows - 1)
+            break;
+
+        if (best != INT_MAX) {
+            //smallest distance from (x, y) to a seed outside the block, sides at the grid edge have no seeds behind them
+            long long gap = -1;
+            if (left > 0) {
+                const long long d = x - left * size + 1;
+                gap = d;
+            }
+            if (right < index->cols - 1) {
+                const long long d = (right + 1) * size - x;
+                if (gap < 0 || d < gap) gap = d;
+            }
+            if (top > 0) {
+                const long long d = y - top * size + 1;
+                if (gap < 0 || d < gap) gap = d;
+            }
+            if (bottom < index->rows - 1) {
+                const long long d = (bottom + 1) * size - y;
+                if (gap < 0 || d < gap) gap = d;
+            }
+
+            //equal distance has to keep searching, a tie may come from a lower index
+            if (gap > 0 && gap * gap > bestDistance)
+                break;
+        }
+    }
+
+    return best != INT_MAX ? best : -1;
+}
+
+void seedIndexFree(SeedIndex *index) {
+    free(index->bucketStart);
+    free(index->seedX);
+    free(index->seedY);
+    free(index->seedId);
+
+    index->bucketStart = NULL;
+    index->seedX = NULL;
+    index->seedY = NULL;
+    index->seedId = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->bucketCapacity = 0;
+    index->scan = NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef SEED_INDEX_H
+#define SEED_INDEX_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "seed_kernel.h"
+
+/*uniform grid of buckets over the region seeds. Seeds are counting sorted by bucket, so every bucket is
+ *a contiguous range of the x/y/id arrays and a nearest seed query only looks at the buckets around
+ *the query point instead of at every seed */
+typedef struct {
+    int bucketSize; // side of a square bucket in pixels
+    int cols;
+    int rows;
+
+    int *bucketStart; // cols * rows + 1 offsets into the seed arrays
+
+    int *seedX;
+    int *seedY;
+    int *seedId; // index of the seed in the array the index was built from
+
+    int count;
+    int capacity;
+    int bucketCapacity;
+
+    SeedKernel kernel; // picked for the cpu by seedIndexBuild
+    SeedScan scan;
+} SeedIndex;
+
+/*(re)build the index over count points inside a width*height plane, neither side above SeedKernel_MaxCoordinate + 1. stride is the distance in bytes between
+ *two consecutive points, so the index can be built straight from an array of structs holding an SDL_Point.
+ *Storage is reused between builds and only grows. Returns false if memory could not be allocated */
+bool seedIndexBuild(SeedIndex *index, const SDL_Point *points, size_t stride, int count, int width, int height);
+
+/*index of the seed closest to (x, y), equal distances go to the lower index just like a linear scan does.
+ *-1 if the index is empty */
+int seedIndexNearest(const SeedIndex *index, int x, int y);
+
+//use another nearest seed kernel, for comparing them. Has to be called after seedIndexBuild
+void seedIndexSetKernel(SeedIndex *index, SeedKernel kernel);
+
+void seedIndexFree(SeedIndex *index);
+
+#endif
@@ -0,0 +1,181 @@
+#include "seed_kernel.h"
+
+#include <limits.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define Seed_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+//the simd kernels are compiled for their instruction set on their own and only called when the cpu has it
+#if defined(Seed_X86) && (defined(__GNUC__) || defined(__clang__))
+#define Seed_TargetSSE2 __attribute__((target("sse2")))
+#define Seed_TargetAVX2 __attribute__((target("avx2")))
+#elif defined(Seed_X86)
+#define Seed_TargetSSE2
+#define Seed_TargetAVX2
+#endif
+
+static void scanScalar(const int *xs, const int *ys, const int *ids, const int from, const int to,
+    const int x, const int y, int *best, int *bestDistance) {
+    int bestId = *best;
+    int bestD = *bestDistance;
+
+    for (int s = from; s < to; ++s) {
+        const int dx = x - xs[s];
+        const int dy = y - ys[s];
+        const int d = dx * dx + dy * dy;
+
+        if (d < bestD || (d == bestD && ids[s] < bestId)) {
+            bestD = d;
+            bestId = ids[s];
+        }
+    }
+
+    *best = bestId;
+    *bestDistance = bestD;
+}
+
+#ifdef Seed_X86
+
+//lanes hold their own best seed, the smallest (distance, id) of all of them is the answer
+static void reduceLanes(const int *laneDistance, const int *laneId, const int lanes, int *best, int *bestDistance) {
+    for (int i = 0; i < lanes; ++i) {
+        if (laneDistance[i] < *bestDistance || (laneDistance[i] == *bestDistance && laneId[i] < *best)) {
+            *bestDistance = laneDistance[i];
+            *best = laneId[i];
+        }
+    }
+}
+
+/*sse2 has no 32 bit multiply, so the differences are packed to 16 bits, interleaved as dx, dy pairs and
+ *squared and summed with one multiply-add. Selection is done with masks, there are no branches per seed */
+Seed_TargetSSE2 static void scanSSE2(const int *xs, const int *ys, const int *ids, const int from, const int to,
+    const int x, const int y, int *best, int *bestDistance) {
+    int s = from;
+
+    if (to - s >= 8) {
+        const __m128i qx = _mm_set1_epi32(x);
+        const __m128i qy = _mm_set1_epi32(y);
+        __m128i bestD = _mm_set1_epi32(*bestDistance);
+        __m128i bestI = _mm_set1_epi32(*best);
+
+        for (; s + 8 <= to; s += 8) {
+            const __m128i dx = _mm_packs_epi32(_mm_sub_epi32(qx, _mm_loadu_si128((const __m128i*)(xs + s))),
+                _mm_sub_epi32(qx, _mm_loadu_si128((const __m128i*)(xs + s + 4))));
+            const __m128i dy = _mm_packs_epi32(_mm_sub_epi32(qy, _mm_loadu_si128((const __m128i*)(ys + s))),
+                _mm_sub_epi32(qy, _mm_loadu_si128((const __m128i*)(ys + s + 4))));
+
+            for (int half = 0; half < 2; ++half) {
+                const __m128i pairs = half == 0 ? _mm_unpacklo_epi16(dx, dy) : _mm_unpackhi_epi16(dx, dy);
+                const __m128i d = _mm_madd_epi16(pairs, pairs);
+                const __m128i id = _mm_loadu_si128((const __m128i*)(ids + s + half * 4));
+
+                const __m128i closer = _mm_or_si128(_mm_cmpgt_epi32(bestD, d),
+                    _mm_and_si128(_mm_cmpeq_epi32(bestD, d), _mm_cmpgt_epi32(bestI, id)));
+                bestD = _mm_or_si128(_mm_and_si128(closer, d), _mm_andnot_si128(closer, bestD));
+                bestI = _mm_or_si128(_mm_and_si128(closer, id), _mm_andnot_si128(closer, bestI));
+            }
+        }
+
+        int laneDistance[4];
+        int laneId[4];
+        _mm_storeu_si128((__m128i*)laneDistance, bestD);
+        _mm_storeu_si128((__m128i*)laneId, bestI);
+        reduceLanes(laneDistance, laneId, 4, best, bestDistance);
+    }
+
+    scanScalar(xs, ys, ids, s, to, x, y, best, bestDistance);
+}
+
+/*two vectors of 8 seeds per step, what is left over is done by the sse2 kernel. Runs shorter than a vector
+ *are not worth the setup and the lane reduction and go to the scalar loop straight away */
+Seed_TargetAVX2 static void scanAVX2(const int *xs, const int *ys, const int *ids, const int from, const int to,
+    const int x, const int y, int *best, int *bestDistance) {
+    int s = from;
+
+    if (to - s >= 16) {
+        const __m256i qx = _mm256_set1_epi32(x);
+        const __m256i qy = _mm256_set1_epi32(y);
+        __m256i bestD[2] = { _mm256_set1_epi32(*bestDistance), _mm256_set1_epi32(*bestDistance) };
+        __m256i bestI[2] = { _mm256_set1_epi32(*best), _mm256_set1_epi32(*best) };
+
+        for (; s + 16 <= to; s += 16) {
+            for (int half = 0; half < 2; ++half) {
+                const int at = s + half * 8;
+                const __m256i dx = _mm256_sub_epi32(qx, _mm256_loadu_si256((const __m256i*)(xs + at)));
+                const __m256i dy = _mm256_sub_epi32(qy, _mm256_loadu_si256((const __m256i*)(ys + at)));
+                const __m256i d = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+                const __m256i id = _mm256_loadu_si256((const __m256i*)(ids + at));
+
+                const __m256i closer = _mm256_or_si256(_mm256_cmpgt_epi32(bestD[half], d),
+                    _mm256_and_si256(_mm256_cmpeq_epi32(bestD[half], d), _mm256_cmpgt_epi32(bestI[half], id)));
+                bestD[half] = _mm256_blendv_epi8(bestD[half], d, closer);
+                bestI[half] = _mm256_blendv_epi8(bestI[half], id, closer);
+            }
+        }
+
+        int laneDistance[16];
+        int laneId[16];
+        _mm256_storeu_si256((__m256i*)laneDistance, bestD[0]);
+        _mm256_storeu_si256((__m256i*)(laneDistance + 8), bestD[1]);
+        _mm256_storeu_si256((__m256i*)laneId, bestI[0]);
+        _mm256_storeu_si256((__m256i*)(laneId + 8), bestI[1]);
+        reduceLanes(laneDistance, laneId, 16, best, bestDistance);
+
+        //the compiler does not always do this for a function with its own target, without it sse code after us stalls
+        _mm256_zeroupper();
+    }
+
+    scanSSE2(xs, ys, ids, s, to, x, y, best, bestDistance);
+}
+
+#endif
+
+bool seedKernelAvailable(const SeedKernel kernel) {
+    switch (kernel) {
+    case SeedKernel_Scalar:
+        return true;
+#ifdef Seed_X86
+    case SeedKernel_SSE2:
+        return SDL_HasSSE2() == SDL_TRUE;
+    case SeedKernel_AVX2:
+        return SDL_HasAVX2() == SDL_TRUE;
+#endif
+    default:
+        return false;
+    }
+}
+
+SeedKernel seedKernelBest(void) {
+    if (seedKernelAvailable(SeedKernel_AVX2))
+        return SeedKernel_AVX2;
+    if (seedKernelAvailable(SeedKernel_SSE2))
+        return SeedKernel_SSE2;
+    return SeedKernel_Scalar;
+}
+
+SeedScan seedKernelScan(const SeedKernel kernel) {
+    switch (kernel) {
+#ifdef Seed_X86
+    case SeedKernel_SSE2:
+        return scanSSE2;
+    case SeedKernel_AVX2:
+        return scanAVX2;
+#endif
+    default:
+        return scanScalar;
+    }
+}
+
+const char *seedKernelName(const SeedKernel kernel) {
+    switch (kernel) {
+    case SeedKernel_SSE2:
+        return "sse2";
+    case SeedKernel_AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
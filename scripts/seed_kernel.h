@@ -0,0 +1,33 @@
+#ifndef SEED_KERNEL_H
+#define SEED_KERNEL_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+//coordinates have to stay below this so squared distances fit in an int and differences in 16 bits
+#define SeedKernel_MaxCoordinate 32767
+
+typedef enum {
+    SeedKernel_Scalar,
+    SeedKernel_SSE2, // 8 seeds per step, distances with 16 bit multiply-add
+    SeedKernel_AVX2, // 8 seeds per instruction, 16 per step
+    SeedKernel_Count
+} SeedKernel;
+
+/*closest seed to (x, y) among xs/ys[from .. to). *best and *bestDistance hold the best seed id and squared
+ *distance found so far (INT_MAX for both if nothing is found yet) and are replaced when a seed is closer, or
+ *equally close with a lower id. Every kernel gives the same answer */
+typedef void (*SeedScan)(const int *xs, const int *ys, const int *ids, int from, int to, int x, int y,
+    int *best, int *bestDistance);
+
+//fastest kernel this cpu runs
+SeedKernel seedKernelBest(void);
+
+//false for kernels the build or the cpu does not have
+bool seedKernelAvailable(SeedKernel kernel);
+
+SeedScan seedKernelScan(SeedKernel kernel);
+
+const char *seedKernelName(SeedKernel kernel);
+
+#endif
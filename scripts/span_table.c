@@ -0,0 +1,87 @@
+#include "span_table.h"
+
+#include <stdlib.h>
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+/*run over the label map, for every run of a region: counted into regionStart[label + 1] on the first pass,
+ *written at the cursor regionStart[label] on the second */
+static void spanRuns(SpanTable *table, const int *labels, const int cols, const int rows, const bool write) {
+    for (int row = 0; row < rows; ++row) {
+        const int *line = &labels[row * cols];
+
+        int col = 0;
+        while (col < cols) {
+            const int label = line[col];
+            int end = col + 1;
+            while (end < cols && line[end] == label)
+                ++end;
+
+            if (label >= 0) {
+                if (write) {
+                    MapSpan *span = &table->spans[table->regionStart[label]++];
+                    span->row = row;
+                    span->start = col;
+                    span->end = end;
+                } else {
+                    table->regionStart[label + 1]++;
+                }
+            }
+            col = end;
+        }
+    }
+}
+
+bool spanTableBuild(SpanTable *table, const int *labels, const int cols, const int rows, const int regionCount) {
+    table->count = 0;
+    table->regionCount = 0;
+
+    if (regionCount + 1 > table->regionCapacity) {
+        if (!resizeArray((void**)&table->regionStart, regionCount + 1, sizeof(int)))
+            return false;
+        table->regionCapacity = regionCount + 1;
+    }
+
+    //a counting sort by region, so the table is sized exactly and each region keeps its spans top to bottom
+    int *start = table->regionStart;
+    for (int i = 0; i <= regionCount; ++i)
+        start[i] = 0;
+    spanRuns(table, labels, cols, rows, false);
+    for (int i = 1; i <= regionCount; ++i)
+        start[i] += start[i - 1];
+
+    if (start[regionCount] > table->capacity) {
+        if (!resizeArray((void**)&table->spans, start[regionCount], sizeof(MapSpan)))
+            return false;
+        table->capacity = start[regionCount];
+    }
+
+    //start[i] is the write cursor of region i, afterwards it holds the end of the region and is shifted back
+    spanRuns(table, labels, cols, rows, true);
+    for (int i = regionCount; i > 0; --i)
+        start[i] = start[i - 1];
+    start[0] = 0;
+
+    table->count = start[regionCount];
+    table->regionCount = regionCount;
+    return true;
+}
+
+void spanTableFree(SpanTable *table) {
+    free(table->spans);
+    free(table->regionStart);
+
+    table->spans = NULL;
+    table->regionStart = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->regionCount = 0;
+    table->regionCapacity = 0;
+}
@@ -0,0 +1,34 @@
+#ifndef SPAN_TABLE_H
+#define SPAN_TABLE_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+//cells start .. end - 1 of one row
+typedef struct {
+    int row;
+    int start;
+    int end;
+} MapSpan;
+
+/*every region as horizontal runs of its cells. A voronoi region is convex, so it crosses a row in one piece,
+ *only cut where a border runs through it. The spans of a region are stored together, top to bottom, so it can
+ *be repainted by filling exactly its cells whatever the shape of the box around it. Buffers are kept between
+ *builds and only grow */
+typedef struct {
+    MapSpan *spans;
+    int count;
+    int capacity;
+
+    int *regionStart; // regionCount + 1 offsets into spans
+    int regionCount;
+    int regionCapacity;
+} SpanTable;
+
+/*spans of the cells of a map of cols * rows labels, row by row, labeled 0 .. regionCount - 1. Negative labels
+ *belong to no region and get no span. Returns false if memory could not be allocated, the table is empty then */
+bool spanTableBuild(SpanTable *table, const int *labels, int cols, int rows, int regionCount);
+
+void spanTableFree(SpanTable *table);
+
+#endif
@@ -0,0 +1,239 @@
+#include "voronoi_polygons.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+static bool resizeArray(void **array, const size_t needed, const size_t elementSize) {
+    void *memory = realloc(*array, needed * elementSize);
+    if (!memory)
+        return false;
+
+    *array = memory;
+    return true;
+}
+
+static const SDL_Point *pointAt(const SDL_Point *points, const size_t stride, const int i) {
+    return (const SDL_Point*)((const char*)points + (size_t)i * stride);
+}
+
+/*room for every polygon of the map. A region gets at most the four sides of the rectangle and one side per
+ *neighbour, a polygon of k corners is k - 2 triangles and a pair of neighbours one quad of two triangles */
+static bool polygonsReserve(VoronoiPolygons *polygons, const int count, const int pairs, const int maxDegree) {
+    const int points = count * 4 + pairs * 3;
+    const int indices = (count * 2 + pairs) * 3 + pairs * 3;
+    const int corners = maxDegree + 4;
+
+    if (points > polygons->capacity) {
+        if (!resizeArray((void**)&polygons->vertices, points, sizeof(SDL_Vertex)) ||
+            !resizeArray((void**)&polygons->across, points, sizeof(int)))
+            return false;
+        polygons->capacity = points;
+    }
+    if (indices > polygons->indexCapacity) {
+        if (!resizeArray((void**)&polygons->indices, indices, sizeof(int)))
+            return false;
+        polygons->indexCapacity = indices;
+    }
+    if (count + 1 > polygons->regionCapacity) {
+        if (!resizeArray((void**)&polygons->regionStart, count + 1, sizeof(int)))
+            return false;
+        polygons->regionCapacity = count + 1;
+    }
+    if (corners > polygons->clipCapacity) {
+        if (!resizeArray((void**)&polygons->clip, (size_t)corners * 4, sizeof(double)) ||
+            !resizeArray((void**)&polygons->clipEdges, (size_t)corners * 2, sizeof(int)))
+            return false;
+        polygons->clipCapacity = corners;
+    }
+    return true;
+}
+
+/*keep the part of the polygon in (x, y pairs, relative to the seed) on the side of the seed, the side where
+ *p . q <= |q|^2 / 2 for the neighbour q. Corners on the bisector stay and give no extra crossing, so cutting
+ *through a corner does not repeat it. Every corner carries the edge to the next one: a cut edge keeps its own,
+ *the new edge along the bisector gets neighbour. Returns the corners written to out */
+static int clipBisector(const double *in, const int *inEdges, const int corners, const double qx, const double qy,
+    const int neighbour, double *out, int *outEdges) {
+    const double limit = (qx * qx + qy * qy) * 0.5;
+    int written = 0;
+
+    for (int k = 0; k < corners; ++k) {
+        const double *a = &in[k * 2];
+        const double *b = &in[(k + 1 < corners ? k + 1 : 0) * 2];
+        const double fa = a[0] * qx + a[1] * qy - limit;
+        const double fb = b[0] * qx + b[1] * qy - limit;
+
+        if (fa <= 0) {
+            out[written * 2] = a[0];
+            out[written * 2 + 1] = a[1];
+            //a corner on the bisector with the next one outside is where the polygon leaves along it
+            outEdges[written] = fa == 0 && fb > 0 ? neighbour : inEdges[k];
+            ++written;
+        }
+        if ((fa < 0 && fb > 0) || (fa > 0 && fb < 0)) {
+            const double t = fa / (fa - fb);
+            out[written * 2] = a[0] + t * (b[0] - a[0]);
+            out[written * 2 + 1] = a[1] + t * (b[1] - a[1]);
+            outEdges[written] = fa < 0 ? neighbour : inEdges[k];
+            ++written;
+        }
+    }
+    return written;
+}
+
+static void vertexSet(SDL_Vertex *vertex, const float x, const float y, const SDL_Color color) {
+    vertex->position.x = x;
+    vertex->position.y = y;
+    vertex->color = color;
+    vertex->tex_coord.x = 0.0f;
+    vertex->tex_coord.y = 0.0f;
+}
+
+/*the border from a to b as a quad of the given width, both ends stretched by half of it so the quads of the
+ *borders that meet in a corner close it */
+static void borderAdd(VoronoiPolygons *polygons, const SDL_FPoint a, const SDL_FPoint b, const float width,
+    const SDL_Color color) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f)
+        return;
+
+    const float ux = dx / length * width * 0.5f;
+    const float uy = dy / length * width * 0.5f;
+    const int base = polygons->count;
+    vertexSet(&polygons->vertices[base], a.x - ux - uy, a.y - uy + ux, color);
+    vertexSet(&polygons->vertices[base + 1], b.x + ux - uy, b.y + uy + ux, color);
+    vertexSet(&polygons->vertices[base + 2], b.x + ux + uy, b.y + uy - ux, color);
+    vertexSet(&polygons->vertices[base + 3], a.x - ux + uy, a.y - uy - ux, color);
+    polygons->count += 4;
+
+    static const int QUAD[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int k = 0; k < 6; ++k)
+        polygons->indices[polygons->indexCount++] = base + QUAD[k];
+    polygons->borderCount++;
+}
+
+bool voronoiPolygonsBuild(VoronoiPolygons *polygons, const SDL_Point *points, const size_t stride, const int count,
+    const int width, const int height, const int *start, const int *list, const float borderWidth,
+    const SDL_Color border) {
+    int maxDegree = 0;
+    for (int i = 0; i < count; ++i) {
+        if (start[i + 1] - start[i] > maxDegree)
+            maxDegree = start[i + 1] - start[i];
+    }
+
+    polygons->count = 0;
+    polygons->indexCount = 0;
+    polygons->regionCount = 0;
+    polygons->borderCount = 0;
+    if (!polygonsReserve(polygons, count, start[count], maxDegree))
+        return false;
+
+    const SDL_Color white = { 255, 255, 255, 255 };
+    for (int i = 0; i < count; ++i) {
+        const SDL_Point *seed = pointAt(points, stride, i);
+        double *polygon = polygons->clip;
+        double *next = polygons->clip + (size_t)polygons->clipCapacity * 2;
+        int *edges = polygons->clipEdges;
+        int *nextEdges = polygons->clipEdges + polygons->clipCapacity;
+
+        /*the map rectangle around the seed, its sides border no region, cut down by one bisector after the other.
+         *Pixel x covers [x, x + 1) on screen, so the seed and every pixel it is compared with in picking sit at the
+         *center of their pixel, half a pixel in */
+        const double centerX = seed->x + 0.5;
+        const double centerY = seed->y + 0.5;
+        const double rectangle[8] = {
+            -centerX, -centerY,
+            -centerX, height - centerY,
+            width - centerX, height - centerY,
+            width - centerX, -centerY
+        };
+        int corners = 4;
+        for (int k = 0; k < 8; ++k)
+            polygon[k] = rectangle[k];
+        for (int k = 0; k < 4; ++k)
+            edges[k] = -1;
+
+        for (int k = start[i]; k < start[i + 1] && corners >= 3; ++k) {
+            const SDL_Point *other = pointAt(points, stride, list[k]);
+            corners = clipBisector(polygon, edges, corners, other->x - seed->x, other->y - seed->y, list[k], next,
+                nextEdges);
+
+            double *swap = polygon;
+            polygon = next;
+            next = swap;
+            int *swapEdges = edges;
+            edges = nextEdges;
+            nextEdges = swapEdges;
+        }
+
+        //a region cut down to nothing (only possible with neighbours that are not exact) gets no polygon
+        polygons->regionStart[i] = polygons->count;
+        if (corners < 3)
+            continue;
+
+        const int base = polygons->count;
+        for (int k = 0; k < corners; ++k) {
+            vertexSet(&polygons->vertices[base + k], (float)(polygon[k * 2] + centerX),
+                (float)(polygon[k * 2 + 1] + centerY), white);
+        }
+        polygons->count += corners;
+
+        //a fan from the first corner
+        int *index = &polygons->indices[polygons->indexCount];
+        for (int k = 1; k + 1 < corners; ++k) {
+            *index++ = base;
+            *index++ = base + k;
+            *index++ = base + k + 1;
+        }
+        polygons->indexCount += (corners - 2) * 3;
+
+        for (int k = 0; k < corners; ++k)
+            polygons->across[base + k] = edges[k];
+    }
+    polygons->regionStart[count] = polygons->count;
+    polygons->regionCount = count;
+
+    //every border once, from the region with the lower index, after all the polygons so it is drawn over them
+    for (int i = 0; i < count; ++i) {
+        const int first = polygons->regionStart[i];
+        const int corners = polygons->regionStart[i + 1] - first;
+        for (int k = 0; k < corners; ++k) {
+            if (polygons->across[first + k] > i) {
+                borderAdd(polygons, polygons->vertices[first + k].position,
+                    polygons->vertices[first + (k + 1 < corners ? k + 1 : 0)].position, borderWidth, border);
+            }
+        }
+    }
+    return true;
+}
+
+void voronoiPolygonsColor(VoronoiPolygons *polygons, const int region, const SDL_Color color) {
+    for (int k = polygons->regionStart[region]; k < polygons->regionStart[region + 1]; ++k)
+        polygons->vertices[k].color = color;
+}
+
+void voronoiPolygonsFree(VoronoiPolygons *polygons) {
+    free(polygons->vertices);
+    free(polygons->across);
+    free(polygons->indices);
+    free(polygons->regionStart);
+    free(polygons->clip);
+    free(polygons->clipEdges);
+
+    polygons->vertices = NULL;
+    polygons->across = NULL;
+    polygons->indices = NULL;
+    polygons->regionStart = NULL;
+    polygons->clip = NULL;
+    polygons->clipEdges = NULL;
+    polygons->count = 0;
+    polygons->capacity = 0;
+    polygons->indexCount = 0;
+    polygons->indexCapacity = 0;
+    polygons->regionCount = 0;
+    polygons->regionCapacity = 0;
+    polygons->borderCount = 0;
+    polygons->clipCapacity = 0;
+}
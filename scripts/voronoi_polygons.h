@@ -0,0 +1,52 @@
+#ifndef VORONOI_POLYGONS_H
+#define VORONOI_POLYGONS_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+//SDL_Vertex and SDL_RenderGeometry came with 2.0.18
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "The voronoi polygons need SDL 2.0.18 or newer"
+#endif
+
+/*the voronoi cell of every region as a convex polygon clipped to the map, in pixel coordinates with every seed at
+ *the center of its pixel, the way picking measures distances. The corners of region i are
+ *vertices[regionStart[i] .. regionStart[i + 1]) in order around it, in the color of the region. After the last
+ *region come the borders: every border two regions share is one thin quad of four vertices, made
+ *once for the pair, the sides of the map get none. indices cut every polygon into a fan of triangles and every
+ *quad into two, polygons first, so the whole map with its borders is one list of triangles drawn in order.
+ *Buffers are kept between builds and only grow */
+typedef struct {
+    SDL_Vertex *vertices;
+    int *across; // per region corner, the region on the other side of the edge to the next corner, -1 for the map
+    int count;
+    int capacity;
+
+    int *indices; // three vertices per triangle
+    int indexCount;
+    int indexCapacity;
+
+    int *regionStart; // regionCount + 1 offsets into vertices, the border quads start at regionStart[regionCount]
+    int regionCount;
+    int regionCapacity;
+    int borderCount; // quads
+
+    double *clip; // scratch for clipping one polygon, two corner lists of x, y pairs
+    int *clipEdges; // per corner of the scratch lists, the neighbour whose bisector runs to the next corner
+    int clipCapacity; // in corners per list
+} VoronoiPolygons;
+
+/*clip the width*height rectangle with the bisector of every region and each of its neighbours, the neighbours of
+ *region i being list[start[i] .. start[i + 1]). With the delaunay neighbours that is exactly the voronoi cell.
+ *stride is the distance in bytes between two consecutive points. Every region starts out white, the borders are
+ *borderWidth pixels wide in the border color. Returns false if memory could not be allocated, the polygons are
+ *empty then */
+bool voronoiPolygonsBuild(VoronoiPolygons *polygons, const SDL_Point *points, size_t stride, int count,
+    int width, int height, const int *start, const int *list, float borderWidth, SDL_Color border);
+
+//give every vertex of one region a color
+void voronoiPolygonsColor(VoronoiPolygons *polygons, int region, SDL_Color color);
+
+void voronoiPolygonsFree(VoronoiPolygons *polygons);
+
+#endif
@@ -0,0 +1,133 @@
+#include "worker_pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//more threads than this do not pay off for maps of screen size
+#define Pool_MaxThreads 63
+
+//take tasks until the batch runs dry
+static void drainTasks(WorkerPool *pool) {
+    for (;;) {
+        const int task = SDL_AtomicAdd(&pool->nextTask, 1);
+        if (task >= pool->taskCount)
+            return;
+        pool->job(pool->context, task);
+    }
+}
+
+static int workerMain(void *data) {
+    WorkerPool *pool = (WorkerPool*)data;
+    Uint32 seen = 0;
+
+    SDL_LockMutex(pool->lock);
+    for (;;) {
+        while (pool->batch == seen && !pool->quit)
+            SDL_CondWait(pool->wake, pool->lock);
+        if (pool->quit)
+            break;
+        seen = pool->batch;
+
+        SDL_UnlockMutex(pool->lock);
+        drainTasks(pool);
+        SDL_LockMutex(pool->lock);
+
+        if (--pool->busy == 0)
+            SDL_CondSignal(pool->done);
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+void workerPoolStart(WorkerPool *pool, int threadCount) {
+    pool->threads = NULL;
+    pool->threadCount = 0;
+    pool->lock = NULL;
+    pool->wake = NULL;
+    pool->done = NULL;
+    pool->busy = 0;
+    pool->batch = 0;
+    pool->quit = false;
+
+    if (threadCount < 0)
+        threadCount = SDL_GetCPUCount() - 1;
+    if (threadCount > Pool_MaxThreads)
+        threadCount = Pool_MaxThreads;
+    if (threadCount <= 0)
+        return;
+
+    pool->lock = SDL_CreateMutex();
+    pool->wake = SDL_CreateCond();
+    pool->done = SDL_CreateCond();
+    pool->threads = (SDL_Thread**)malloc(threadCount * sizeof(SDL_Thread*));
+    if (!pool->lock || !pool->wake || !pool->done || !pool->threads) {
+        fprintf(stderr, "Failed to set up the worker threads, running on one thread\n");
+        workerPoolStop(pool);
+        return;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        pool->threads[i] = SDL_CreateThread(workerMain, "worker", pool);
+        if (!pool->threads[i]) {
+            fprintf(stderr, "Could not create worker thread! SDL_Error: %s\n", SDL_GetError());
+            break;
+        }
+        pool->threadCount++;
+    }
+}
+
+void workerPoolRun(WorkerPool *pool, const WorkerJob job, void *context, const int taskCount) {
+    if (pool->threadCount == 0 || taskCount <= 1) {
+        for (int task = 0; task < taskCount; ++task)
+            job(context, task);
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    pool->job = job;
+    pool->context = context;
+    pool->taskCount = taskCount;
+    SDL_AtomicSet(&pool->nextTask, 0);
+    pool->busy = pool->threadCount;
+    pool->batch++;
+    SDL_CondBroadcast(pool->wake);
+    SDL_UnlockMutex(pool->lock);
+
+    drainTasks(pool);
+
+    SDL_LockMutex(pool->lock);
+    while (pool->busy > 0)
+        SDL_CondWait(pool->done, pool->lock);
+    SDL_UnlockMutex(pool->lock);
+}
+
+int workerPoolSize(const WorkerPool *pool) {
+    return pool->threadCount + 1;
+}
+
+void workerPoolStop(WorkerPool *pool) {
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = true;
+        if (pool->wake)
+            SDL_CondBroadcast(pool->wake);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    for (int i = 0; i < pool->threadCount; ++i)
+        SDL_WaitThread(pool->threads[i], NULL);
+
+    free(pool->threads);
+    if (pool->done)
+        SDL_DestroyCond(pool->done);
+    if (pool->wake)
+        SDL_DestroyCond(pool->wake);
+    if (pool->lock)
+        SDL_DestroyMutex(pool->lock);
+
+    pool->threads = NULL;
+    pool->threadCount = 0;
+    pool->lock = NULL;
+    pool->wake = NULL;
+    pool->done = NULL;
+}
@@ -0,0 +1,43 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <SDL.h>
+#include <stdbool.h>
+
+//one piece of a batch, task goes from 0 to the task count of the batch
+typedef void (*WorkerJob)(void *context, int task);
+
+/*SDL threads that sleep until a batch of tasks is handed to them. The thread that runs a batch works on it too
+ *and only returns when every task is finished, so a batch behaves like a plain loop that is spread over the cores.
+ *Tasks are taken one at a time from a shared counter, so uneven tasks still keep every thread busy */
+typedef struct {
+    SDL_Thread **threads;
+    int threadCount; // threads besides the caller, 0 runs every batch on the caller alone
+
+    SDL_mutex *lock;
+    SDL_cond *wake; // a new batch or quit
+    SDL_cond *done; // the last worker left the batch
+
+    WorkerJob job;
+    void *context;
+    int taskCount;
+    SDL_atomic_t nextTask;
+
+    int busy; // workers still inside the current batch
+    Uint32 batch; // bumped for every batch, workers compare it with the last one they ran
+    bool quit;
+} WorkerPool;
+
+/*start threadCount workers, a negative count picks one less than the cpu count. If threads can't be created the pool keeps
+ *the ones it has, possibly none, and still works */
+void workerPoolStart(WorkerPool *pool, int threadCount);
+
+//run job for every task in 0 .. taskCount - 1 and wait for all of them
+void workerPoolRun(WorkerPool *pool, WorkerJob job, void *context, int taskCount);
+
+//threads running a batch, the caller included
+int workerPoolSize(const WorkerPool *pool);
+
+void workerPoolStop(WorkerPool *pool);
+
+#endif